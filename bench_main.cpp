@@ -0,0 +1,717 @@
+// Benchmark runner
+// Runs a fixed set of scenarios at several cell counts and reports every TimerManager pass
+// (grid clear/assign/prefix sum/insert, physics, update, internal update, culling, rendering, whole tick)
+// with percentiles as JSON, so builds can be compared on headless machines (CI, render nodes).
+// Scenarios are seeded identically on every run, so two reports differ only by the build and the machine.
+// A one-line summary per run goes to stderr, so the report can still be written to stdout.
+// Run it from the directory that contains shaders/, same as the main executable.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <glad/glad.h>
+
+// Core includes
+#include "src/core/config.h"
+
+// Simulation includes
+#include "src/simulation/cell/genome_io.h"
+#include "src/simulation/backend/gpu_backend.h"
+#include "src/simulation/backend/cpu_backend.h"
+#include "src/simulation/backend/collision_kernel.h"
+
+// Rendering includes
+#include "src/rendering/camera/camera.h"
+#include "src/rendering/core/shader_class.h"
+#include "src/rendering/core/headless_context.h"
+
+// Utility includes
+#include "src/utils/timer.h"
+#include "src/utils/json_writer.h"
+
+enum class Scenario
+{
+	Uniform,  // Cells spread over the whole spawn radius, no division
+	Dense,    // The same cells packed into a ball of about one cell per unit volume, no division
+	Division, // A single cell dividing every interval until the population reaches the run size
+	Chain     // Like Division, but every split links its daughters and child A keeps the parent's adhesions
+};
+
+struct ScenarioInfo
+{
+	Scenario scenario;
+	const char* name;
+};
+
+static const ScenarioInfo SCENARIOS[] = {
+	{ Scenario::Uniform, "uniform" },
+	{ Scenario::Dense, "dense" },
+	{ Scenario::Division, "division" },
+	{ Scenario::Chain, "chain" },
+};
+
+// Offscreen target size for the render passes
+static constexpr int RENDER_WIDTH = 1920;
+static constexpr int RENDER_HEIGHT = 1080;
+
+// Split interval for the scenarios that must not grow
+static constexpr float NEVER_SPLIT = 1.0e9f;
+
+// Stability search (--stability): every integrator runs a settled packing for STABILITY_DURATION simulated
+// seconds at growing time steps, from STABILITY_FIRST_STEP by STABILITY_STEP_FACTOR up to STABILITY_LAST_STEP.
+// The packing is a cubic lattice of touching cells, so no contact pushes yet, and every cell gets a kick of
+// STABILITY_KICK_SPEED in a random direction (the same kicks at every step). Damped contacts can't make the
+// cells much faster than that; a step counts as stable as long as no speed turns non-finite and the fastest
+// cell stays within STABILITY_PEAK_FACTOR of the kick, i.e. the integrator doesn't pump energy into the
+// contacts. (A packing that starts out overlapping flies apart in the first ticks, after which no contacts
+// are left to go unstable.)
+static constexpr float STABILITY_DURATION = 5.0f;
+static constexpr float STABILITY_FIRST_STEP = 0.005f;
+static constexpr float STABILITY_LAST_STEP = 1.0f;
+static constexpr float STABILITY_STEP_FACTOR = 1.25f;
+static constexpr float STABILITY_KICK_SPEED = 1.0f;
+static constexpr float STABILITY_PEAK_FACTOR = 2.0f;
+
+struct BenchOptions
+{
+	std::vector<ScenarioInfo> scenarios{ std::begin(SCENARIOS), std::end(SCENARIOS) };
+	std::vector<int> sizes{ 1000, 10000, 100000, 1000000 };
+	int ticks = 200;                          // Measured ticks per run
+	int warmupTicks = 20;                     // Ticks run before measuring (caches, driver shader recompiles)
+	float timeStep = config::physicsTimeStep;
+	bool render = true;                       // GPU backend only: cull and draw into an offscreen target every tick
+	bool fusedPhysics = false;                // GPU backend only: physics and integration in one pass (one timer); off
+	                                          // by default so that the report times physics and update separately
+	bool hashedGrid = config::defaultUseHashedGrid;     // GPU backend only: hashed sparse grid, no world walls
+	bool multiLevelGrid = config::defaultUseMultiLevelGrid; // Power of two dense grid levels
+	bool neighborLists = config::defaultUseNeighborLists; // GPU backend only: Verlet neighbour lists
+	bool adaptiveTimeStep = config::defaultUseAdaptiveTimeStep; // GPU backend only: per-tick time step from the GPU reductions (--dt is ignored)
+	bool sleeping = config::defaultUseSleeping; // GPU backend only: skip resting cells in physics and integration
+	HeadlessContextPlatform contextPlatform = HeadlessContextPlatform::Surfaceless;
+	bool useCPU = false;
+	int threads = 0;                          // CPU backend threads, 0 = all hardware threads
+	int reorderInterval = config::defaultMortonReorderInterval; // Ticks between Morton reorders, 0 = off
+	config::Integrator integrator = config::defaultIntegrator;
+	bool stability = false;                   // Also search the largest stable time step of every integrator
+	std::string outputPath = "bench_report.json"; // "-" = stdout (the logs go to stderr then)
+};
+
+static void printUsage()
+{
+	std::cout <<
+		"Usage: biospheres_bench [options]\n"
+		"  --scenarios LIST   Comma separated: uniform,dense,division,chain (default all)\n"
+		"  --sizes LIST       Comma separated cell counts (default 1000,10000,100000,1000000)\n"
+		"  --ticks N          Measured ticks per run (default 200)\n"
+		"  --warmup N         Unmeasured ticks before each run (default 20)\n"
+		"  --dt SECONDS       Simulation time per tick (default config::physicsTimeStep)\n"
+		"  --render on|off    Culling and rendering passes, gpu backend only (default on)\n"
+		"  --fused on|off     Fused physics + integration pass, timed as one, gpu backend only (default off)\n"
+		"  --grid TYPE        dense | multilevel | hashed spatial grid, hashed is gpu backend only (default dense)\n"
+		"  --neighbor-lists on|off  Verlet neighbour lists, gpu backend only (default off)\n"
+		"  --adaptive-dt on|off     Adaptive time step instead of --dt, gpu backend only (default off)\n"
+		"  --sleeping on|off  Skip resting cells in physics and integration, gpu backend only (default off)\n"
+		"  --integrator NAME  euler | verlet | semi-implicit (default euler)\n"
+		"  --stability on|off Largest stable time step of every integrator, kicked packing of the first size (default off)\n"
+		"  --backend NAME     gpu | cpu (default gpu)\n"
+		"  --threads N        CPU backend threads, 0 = all hardware threads (default 0)\n"
+		"  --reorder N        Ticks between Morton reorders of cell storage, 0 = off (default 128)\n"
+		"  --context PLATFORM surfaceless | device, EGL platform of the gpu backend (default surfaceless,\n"
+		"                     ignored on Windows)\n"
+		"  --output FILE      JSON report path, - for stdout (default bench_report.json)\n";
+}
+
+static std::vector<std::string> splitList(const std::string& list)
+{
+	std::vector<std::string> items;
+	std::stringstream stream(list);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		if (!item.empty()) items.push_back(item);
+	}
+	return items;
+}
+
+static bool parseArgs(int argc, char** argv, BenchOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--help" || arg == "-h")
+		{
+			return false;
+		}
+		if (i + 1 >= argc)
+		{
+			std::cerr << "Missing value for " << arg << "\n";
+			return false;
+		}
+		std::string value = argv[++i];
+
+		if (arg == "--ticks") options.ticks = std::atoi(value.c_str());
+		else if (arg == "--warmup") options.warmupTicks = std::atoi(value.c_str());
+		else if (arg == "--dt") options.timeStep = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--output") options.outputPath = value;
+		else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+		else if (arg == "--reorder") options.reorderInterval = std::atoi(value.c_str());
+		else if (arg == "--render") options.render = value != "off";
+		else if (arg == "--fused") options.fusedPhysics = value != "off";
+		else if (arg == "--neighbor-lists") options.neighborLists = value == "on";
+		else if (arg == "--adaptive-dt") options.adaptiveTimeStep = value == "on";
+		else if (arg == "--sleeping") options.sleeping = value == "on";
+		else if (arg == "--stability") options.stability = value == "on";
+		else if (arg == "--integrator")
+		{
+			auto found = std::find(std::begin(config::INTEGRATOR_NAMES), std::end(config::INTEGRATOR_NAMES), value);
+			if (found == std::end(config::INTEGRATOR_NAMES))
+			{
+				std::cerr << "Unknown integrator: " << value << "\n";
+				return false;
+			}
+			options.integrator = static_cast<config::Integrator>(found - std::begin(config::INTEGRATOR_NAMES));
+		}
+		else if (arg == "--grid")
+		{
+			options.hashedGrid = value == "hashed";
+			options.multiLevelGrid = value == "multilevel";
+			if (!options.hashedGrid && !options.multiLevelGrid && value != "dense")
+			{
+				std::cerr << "Unknown grid type: " << value << "\n";
+				return false;
+			}
+		}
+		else if (arg == "--sizes")
+		{
+			options.sizes.clear();
+			for (const std::string& size : splitList(value))
+			{
+				options.sizes.push_back(std::atoi(size.c_str()));
+			}
+		}
+		else if (arg == "--scenarios")
+		{
+			options.scenarios.clear();
+			for (const std::string& name : splitList(value))
+			{
+				auto found = std::find_if(std::begin(SCENARIOS), std::end(SCENARIOS),
+					[&](const ScenarioInfo& info) { return name == info.name; });
+				if (found == std::end(SCENARIOS))
+				{
+					std::cerr << "Unknown scenario: " << name << "\n";
+					return false;
+				}
+				options.scenarios.push_back(*found);
+			}
+		}
+		else if (arg == "--backend")
+		{
+			if (value == "gpu") options.useCPU = false;
+			else if (value == "cpu") options.useCPU = true;
+			else
+			{
+				std::cerr << "Unknown backend: " << value << "\n";
+				return false;
+			}
+		}
+		else if (arg == "--context")
+		{
+			if (value == "surfaceless") options.contextPlatform = HeadlessContextPlatform::Surfaceless;
+			else if (value == "device") options.contextPlatform = HeadlessContextPlatform::Device;
+			else
+			{
+				std::cerr << "Unknown context platform: " << value << "\n";
+				return false;
+			}
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << arg << "\n";
+			return false;
+		}
+	}
+
+	bool validSizes = !options.sizes.empty() &&
+		std::all_of(options.sizes.begin(), options.sizes.end(), [](int size) { return size > 0; });
+	if (options.ticks <= 0 || options.warmupTicks < 0 || options.timeStep <= 0.0f || options.threads < 0 || options.reorderInterval < 0 ||
+		options.scenarios.empty() || !validSizes)
+	{
+		std::cerr << "Invalid option value\n";
+		return false;
+	}
+	if (options.useCPU)
+	{
+		options.render = false;
+	}
+	return true;
+}
+
+// Offscreen framebuffer the GPU runs cull and draw into, so those passes show up in the report
+class OffscreenRenderer
+{
+public:
+	OffscreenRenderer()
+		: sphereShader("shaders/rendering/sphere/sphere.vert", "shaders/rendering/sphere/sphere.frag")
+		, camera(glm::vec3(0.0f, 0.0f, 75.0f)) // Same start position as the main window's cameras
+	{
+		glCreateRenderbuffers(1, &colorBuffer);
+		glNamedRenderbufferStorage(colorBuffer, GL_RGBA8, RENDER_WIDTH, RENDER_HEIGHT);
+		glCreateRenderbuffers(1, &depthBuffer);
+		glNamedRenderbufferStorage(depthBuffer, GL_DEPTH_COMPONENT24, RENDER_WIDTH, RENDER_HEIGHT);
+
+		glCreateFramebuffers(1, &framebuffer);
+		glNamedFramebufferRenderbuffer(framebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+		glNamedFramebufferRenderbuffer(framebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+		if (glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cerr << "Offscreen framebuffer is incomplete\n";
+		}
+	}
+
+	~OffscreenRenderer()
+	{
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteRenderbuffers(1, &depthBuffer);
+		sphereShader.destroy();
+	}
+
+	OffscreenRenderer(const OffscreenRenderer&) = delete;
+	OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+
+	void render(CellManager& cellManager)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glViewport(0, 0, RENDER_WIDTH, RENDER_HEIGHT);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		cellManager.renderCells(glm::vec2(RENDER_WIDTH, RENDER_HEIGHT), sphereShader, camera, false);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+private:
+	Shader sphereShader;
+	Camera camera;
+	GLuint framebuffer = 0;
+	GLuint colorBuffer = 0;
+	GLuint depthBuffer = 0;
+};
+
+// Genome and initial cells for one run
+// The static scenarios spawn `size` cells that never divide. The growth scenarios start from one cell
+// whose split interval makes the population reach `size` (the cell limit) a little before the last tick.
+static GenomeData setupScenario(Scenario scenario, int size, const BenchOptions& options, SimulationBackend& backend)
+{
+	GenomeData genome;
+	ModeSettings& mode = genome.modes[0];
+
+	// Same spawn sequence on every run
+	srand(1);
+
+	switch (scenario)
+	{
+	case Scenario::Uniform:
+	case Scenario::Dense:
+	{
+		genome.name = scenario == Scenario::Uniform ? "Bench Uniform" : "Bench Dense";
+		mode.splitInterval = NEVER_SPLIT;
+		mode.parentMakeAdhesion = false;
+		backend.setGenome(genome);
+
+		// One unit of volume per cell (cells have radius 1, so they overlap), kept inside the world bounds
+		float denseRadius = std::min(std::cbrt(3.0f * size / (4.0f * 3.14159f)), config::WORLD_SIZE * 0.45f);
+		backend.setSpawnRadius(scenario == Scenario::Uniform ? config::DEFAULT_SPAWN_RADIUS : denseRadius);
+		backend.spawnCells(size);
+		break;
+	}
+	case Scenario::Division:
+	case Scenario::Chain:
+	{
+		genome.name = scenario == Scenario::Division ? "Bench Division" : "Bench Chain";
+		float runSeconds = (options.warmupTicks + options.ticks) * options.timeStep;
+		float generations = std::ceil(std::log2(static_cast<float>(size))) + 1.0f;
+		mode.splitInterval = runSeconds / generations;
+
+		// A chain grows by one adhesion per split: child B only keeps the link to its sister. With both children
+		// keeping every adhesion, the colony would become a complete graph
+		bool chain = scenario == Scenario::Chain;
+		mode.parentMakeAdhesion = chain;
+		mode.childA.keepAdhesion = chain;
+		mode.childB.keepAdhesion = false;
+		backend.setGenome(genome);
+
+		ComputeCell initialCell{};
+		initialCell.modeIndex = genome.initialMode;
+		initialCell.orientation = genome.initialOrientation;
+		backend.addCell(initialCell);
+		break;
+	}
+	}
+
+	backend.applyPendingCells();
+	return genome;
+}
+
+// Nearest-rank percentile of sorted samples
+static float percentile(const std::vector<float>& sorted, float p)
+{
+	if (sorted.empty()) return 0.0f;
+	size_t rank = static_cast<size_t>(std::ceil(p / 100.0f * sorted.size()));
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+static void writePasses(JsonWriter& json)
+{
+	// Sorted by name so reports from different builds diff cleanly
+	std::map<std::string, TimerStats> passes = TimerManager::instance().getTimers();
+	json.beginObject("passes");
+	for (auto& [name, stats] : passes)
+	{
+		std::vector<float>& samples = stats.samples;
+		std::sort(samples.begin(), samples.end());
+
+		json.beginObject(name.c_str());
+		json.value("samples", static_cast<int>(samples.size()));
+		json.value("meanMs", samples.empty() ? 0.0 : stats.totalTimeMs / samples.size());
+		json.value("minMs", samples.empty() ? 0.0f : samples.front());
+		json.value("p50Ms", percentile(samples, 50.0f));
+		json.value("p90Ms", percentile(samples, 90.0f));
+		json.value("p99Ms", percentile(samples, 99.0f));
+		json.value("maxMs", samples.empty() ? 0.0f : samples.back());
+		json.endObject();
+	}
+	json.endObject();
+}
+
+static std::unique_ptr<SimulationBackend> createBackend(const BenchOptions& options, int cellLimit, int& threads)
+{
+	if (options.useCPU)
+	{
+		auto cpuBackend = std::make_unique<CPUSimulationBackend>(cellLimit, options.threads);
+		cpuBackend->mortonReorderInterval = options.reorderInterval;
+		cpuBackend->useMultiLevelGrid = options.multiLevelGrid;
+		threads = cpuBackend->getThreadCount();
+		return cpuBackend;
+	}
+	threads = 1;
+	auto gpuBackend = std::make_unique<GPUSimulationBackend>(cellLimit);
+	gpuBackend->getCellManager().mortonReorderInterval = options.reorderInterval;
+	gpuBackend->getCellManager().useMultiLevelGrid = options.multiLevelGrid;
+	return gpuBackend;
+}
+
+// One scenario at one size, written as an element of the "runs" array
+static void runBenchmark(JsonWriter& json, const BenchOptions& options, const ScenarioInfo& info, int size, int& threads)
+{
+	json.beginObject();
+	json.value("scenario", info.name);
+	json.value("cells", size);
+
+	std::unique_ptr<SimulationBackend> backend = createBackend(options, size, threads);
+	if (size > backend->getMaxCells())
+	{
+		std::cerr << info.name << " " << size << ": skipped, the " << backend->getName()
+			<< " backend holds at most " << backend->getMaxCells() << " cells\n";
+		json.value("skipped", true);
+		json.value("maxCells", backend->getMaxCells());
+		json.endObject();
+		return;
+	}
+
+	GenomeData genome = setupScenario(info.scenario, size, options, *backend);
+	json.value("genome", genome.name);
+	backend->setIntegrator(options.integrator);
+
+	std::unique_ptr<OffscreenRenderer> renderer;
+	GPUSimulationBackend* gpuBackend = dynamic_cast<GPUSimulationBackend*>(backend.get());
+	if (gpuBackend)
+	{
+		gpuBackend->getCellManager().useFusedPhysics = options.fusedPhysics;
+		gpuBackend->getCellManager().useHashedGrid = options.hashedGrid;
+		gpuBackend->getCellManager().useNeighborLists = options.neighborLists;
+		gpuBackend->getCellManager().useAdaptiveTimeStep = options.adaptiveTimeStep;
+		gpuBackend->getCellManager().useSleeping = options.sleeping;
+	}
+	if (options.render && gpuBackend)
+	{
+		renderer = std::make_unique<OffscreenRenderer>();
+	}
+
+	double simulatedSeconds = 0.0;
+	auto tick = [&]()
+	{
+		TimerCPU timer("Tick");
+		float timeStep = options.timeStep;
+		if (gpuBackend && options.adaptiveTimeStep)
+		{
+			timeStep = gpuBackend->getCellManager().getNextTimeStep();
+		}
+		backend->step(timeStep);
+		simulatedSeconds += timeStep;
+		if (renderer)
+		{
+			renderer->render(gpuBackend->getCellManager());
+		}
+		backend->finish();
+	};
+
+	for (int i = 0; i < options.warmupTicks; i++)
+	{
+		tick();
+	}
+	backend->finish();
+	simulatedSeconds = 0.0;
+
+	// Setup and warmup costs are not part of the report
+	TimerManager::instance().reset();
+	TimerManager::instance().setRecordSamples(true);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < options.ticks; i++)
+	{
+		tick();
+	}
+	auto end = std::chrono::steady_clock::now();
+	double wallSeconds = std::chrono::duration<double>(end - start).count();
+
+	TimerManager::instance().setRecordSamples(false);
+	TimerManager::instance().finalizeFrame();
+	SimulationCounts counts = backend->getCounts();
+
+	json.value("skipped", false);
+	json.value("wallSeconds", wallSeconds);
+	json.value("ticksPerSecond", wallSeconds > 0.0 ? options.ticks / wallSeconds : 0.0);
+	json.value("simulatedSeconds", simulatedSeconds);
+	json.value("simulatedSecondsPerWallSecond", wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0);
+
+	json.beginObject("counts");
+	json.value("totalCells", counts.totalCells);
+	json.value("liveCells", counts.liveCells);
+	json.value("totalAdhesions", counts.totalAdhesions);
+	json.value("liveAdhesions", counts.liveAdhesions);
+	if (gpuBackend && options.sleeping)
+	{
+		json.value("activeCells", gpuBackend->getCellManager().activeCellCount); // Awake at the last tick
+	}
+	json.endObject();
+
+	writePasses(json);
+	json.endObject();
+
+	const TimerStats tickStats = TimerManager::instance().getTimers().at("Tick");
+	std::cerr << info.name << " " << size << ": " << tickStats.averageTimeMs << " ms/tick average, "
+		<< tickStats.maxTimeMs << " ms max, " << counts.totalCells << " cells at the end\n";
+
+	// Renderer and backend GL objects go before the next run creates its own
+	renderer.reset();
+	backend.reset();
+	TimerManager::instance().reset();
+}
+
+// Cells along each side of the stability packing: at least `size` cells, but like the dense scenario's the
+// packing reaches at most 45% of the world size out from the centre (cells are 2 apart)
+static int getStabilityPackingSide(int size)
+{
+	int side = static_cast<int>(std::ceil(std::cbrt(static_cast<float>(size))));
+	return std::min(side, static_cast<int>(config::WORLD_SIZE * 0.45f) + 1);
+}
+
+// The settled packing of the stability search, every cell kicked in a random direction
+static void setupStabilityPacking(int side, SimulationBackend& backend)
+{
+	GenomeData genome;
+	genome.name = "Bench Stability";
+	genome.modes[0].splitInterval = NEVER_SPLIT;
+	genome.modes[0].parentMakeAdhesion = false;
+	backend.setGenome(genome);
+
+	// Same kicks at every time step
+	srand(1);
+
+	// Unit mass cells have radius 1, so cells 2 apart just touch; the lattice is centred on the origin
+	float origin = 1.0f - side;
+	for (int z = 0; z < side; z++)
+	{
+		for (int y = 0; y < side; y++)
+		{
+			for (int x = 0; x < side; x++)
+			{
+				glm::vec3 direction(
+					static_cast<float>(rand()) / RAND_MAX - 0.5f,
+					static_cast<float>(rand()) / RAND_MAX - 0.5f,
+					static_cast<float>(rand()) / RAND_MAX - 0.5f);
+
+				ComputeCell cell{};
+				cell.modeIndex = genome.initialMode;
+				cell.orientation = genome.initialOrientation;
+				cell.positionAndMass = glm::vec4(origin + glm::vec3(x, y, z) * 2.0f, 1.0f);
+				cell.velocity = glm::vec4(glm::normalize(direction) * STABILITY_KICK_SPEED, 0.0f);
+				backend.addCell(cell);
+			}
+		}
+	}
+	backend.applyPendingCells();
+}
+
+// Peak speed of the stability packing over STABILITY_DURATION at one time step (+inf once any speed isn't finite)
+static float runStabilityTrial(const BenchOptions& options, config::Integrator integrator, int side, float timeStep, int& threads)
+{
+	std::unique_ptr<SimulationBackend> backend = createBackend(options, side * side * side, threads);
+	setupStabilityPacking(side, *backend);
+	backend->setIntegrator(integrator);
+
+	int ticks = static_cast<int>(std::ceil(STABILITY_DURATION / timeStep));
+	float peakSpeed = 0.0f;
+	for (int i = 0; i < ticks && std::isfinite(peakSpeed); i++)
+	{
+		backend->step(timeStep);
+		peakSpeed = std::max(peakSpeed, backend->getMaxSpeed());
+	}
+
+	backend.reset();
+	TimerManager::instance().reset();
+	return peakSpeed;
+}
+
+// Largest stable time step of every integrator, written as the "stability" array
+static void runStabilitySearch(JsonWriter& json, const BenchOptions& options, int& threads)
+{
+	// (The CPU backend holds as many cells as it is created for)
+	int size = options.sizes.front();
+	int side = getStabilityPackingSide(std::min(size, createBackend(options, size, threads)->getMaxCells()));
+	size = side * side * side;
+
+	json.beginArray("stability");
+	for (int i = 0; i < static_cast<int>(std::size(config::INTEGRATOR_NAMES)); i++)
+	{
+		config::Integrator integrator = static_cast<config::Integrator>(i);
+		json.beginObject();
+		json.value("integrator", config::INTEGRATOR_NAMES[i]);
+		json.value("cells", size);
+
+		float maxStableStep = 0.0f;
+		json.beginArray("trials");
+		for (float timeStep = STABILITY_FIRST_STEP; timeStep <= STABILITY_LAST_STEP; timeStep *= STABILITY_STEP_FACTOR)
+		{
+			float peakSpeed = runStabilityTrial(options, integrator, side, timeStep, threads);
+			bool stable = std::isfinite(peakSpeed) && peakSpeed <= STABILITY_KICK_SPEED * STABILITY_PEAK_FACTOR;
+
+			json.beginObject();
+			json.value("timeStep", timeStep);
+			json.value("peakSpeed", std::isfinite(peakSpeed) ? peakSpeed : -1.0f);
+			json.value("stable", stable);
+			json.endObject();
+
+			if (!stable) break;
+			maxStableStep = timeStep;
+		}
+		json.endArray();
+
+		json.value("maxStableTimeStep", maxStableStep);
+		json.endObject();
+		std::cerr << "stability " << config::INTEGRATOR_NAMES[i] << ": largest stable time step " << maxStableStep << " s\n";
+	}
+	json.endArray();
+}
+
+static bool runAll(std::ostream& out, const BenchOptions& options)
+{
+	JsonWriter json(out);
+	json.beginObject();
+	json.value("backend", options.useCPU ? "cpu" : "gpu");
+	if (options.useCPU)
+	{
+		json.value("collisionKernel", getCollisionKernelName());
+	}
+	json.value("ticks", options.ticks);
+	json.value("warmupTicks", options.warmupTicks);
+	json.value("timeStep", options.timeStep);
+	json.value("render", options.render);
+	json.value("reorderInterval", options.reorderInterval);
+	json.value("integrator", config::INTEGRATOR_NAMES[static_cast<int>(options.integrator)]);
+	json.value("grid", options.hashedGrid ? "hashed" : options.multiLevelGrid ? "multilevel" : "dense");
+	if (!options.useCPU)
+	{
+		json.value("fusedPhysics", options.fusedPhysics);
+		json.value("neighborLists", options.neighborLists);
+		json.value("adaptiveTimeStep", options.adaptiveTimeStep);
+		json.value("sleeping", options.sleeping);
+	}
+
+	int threads = 1;
+	json.beginArray("runs");
+	for (const ScenarioInfo& info : options.scenarios)
+	{
+		for (int size : options.sizes)
+		{
+			runBenchmark(json, options, info, size, threads);
+		}
+	}
+	json.endArray();
+
+	if (options.stability)
+	{
+		runStabilitySearch(json, options, threads);
+	}
+
+	json.value("threads", threads);
+	json.endObject();
+	out << "\n";
+	return static_cast<bool>(out);
+}
+
+int main(int argc, char** argv)
+{
+	BenchOptions options;
+	if (!parseArgs(argc, argv, options))
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	// With the report on stdout, everything the simulation prints (std::cout) goes to stderr instead, so that
+	// stdout is nothing but the JSON
+	std::ostream reportStdout(std::cout.rdbuf());
+	if (options.outputPath == "-")
+	{
+		std::cout.rdbuf(std::cerr.rdbuf());
+	}
+
+	if (!options.useCPU && !createHeadlessGLContext(options.contextPlatform))
+	{
+		return EXIT_FAILURE;
+	}
+
+	int exitCode = EXIT_SUCCESS;
+	if (options.outputPath == "-")
+	{
+		runAll(reportStdout, options);
+	}
+	else
+	{
+		std::ofstream file(options.outputPath);
+		if (!file || !runAll(file, options))
+		{
+			std::cerr << "Failed to write output file: " << options.outputPath << "\n";
+			exitCode = EXIT_FAILURE;
+		}
+	}
+
+	if (!options.useCPU)
+	{
+		destroyHeadlessGLContext();
+	}
+	std::cout.rdbuf(reportStdout.rdbuf());
+	return exitCode;
+}
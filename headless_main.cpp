@@ -0,0 +1,263 @@
+// Headless batch runner
+// Steps a simulation backend for a fixed number of ticks without a window, ImGui or audio device,
+// then writes per-pass timings and the final cell/adhesion counts as JSON.
+// The GPU backend needs a GL context (EGL without a display, see headless_context.h); the CPU backend needs none.
+// Run it from the directory that contains shaders/, same as the main executable.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <glad/glad.h>
+
+// Core includes
+#include "src/core/config.h"
+
+// Simulation includes
+#include "src/simulation/cell/genome_io.h"
+#include "src/simulation/backend/gpu_backend.h"
+#include "src/simulation/backend/cpu_backend.h"
+#include "src/simulation/backend/collision_kernel.h"
+
+// Rendering includes
+#include "src/rendering/core/headless_context.h"
+
+// Utility includes
+#include "src/utils/timer.h"
+#include "src/utils/json_writer.h"
+
+struct HeadlessOptions
+{
+	int ticks = 1000;
+	float timeStep = config::physicsTimeStep;
+	int cellLimit = config::MAX_CELLS;
+	int spawnCount = 0;                       // Extra random cells on top of the genome's initial cell
+	HeadlessContextPlatform contextPlatform = HeadlessContextPlatform::Surfaceless;
+	bool useCPU = false;                      // CPU backend, no GL context at all
+	int threads = 0;                          // CPU backend threads, 0 = all hardware threads
+	std::string genomePath;                   // Empty = built-in default genome
+	std::string outputPath = "headless_report.json"; // "-" = stdout (the logs go to stderr then)
+};
+
+static void printUsage()
+{
+	std::cout <<
+		"Usage: biospheres_headless [options]\n"
+		"  --ticks N          Number of simulation ticks to run (default 1000)\n"
+		"  --dt SECONDS       Simulation time per tick (default config::physicsTimeStep)\n"
+		"  --genome FILE      Genome file to load (default: built-in default genome)\n"
+		"  --cell-limit N     Cell limit, at most config::MAX_CELLS\n"
+		"  --spawn N          Additionally spawn N random cells\n"
+		"  --backend NAME     gpu | cpu (default gpu)\n"
+		"  --threads N        CPU backend threads, 0 = all hardware threads (default 0)\n"
+		"  --context PLATFORM surfaceless | device, EGL platform of the gpu backend (default surfaceless,\n"
+		"                     ignored on Windows)\n"
+		"  --output FILE      JSON report path, - for stdout (default headless_report.json)\n";
+}
+
+static bool parseArgs(int argc, char** argv, HeadlessOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--help" || arg == "-h")
+		{
+			return false;
+		}
+		if (i + 1 >= argc)
+		{
+			std::cerr << "Missing value for " << arg << "\n";
+			return false;
+		}
+		std::string value = argv[++i];
+
+		if (arg == "--ticks") options.ticks = std::atoi(value.c_str());
+		else if (arg == "--dt") options.timeStep = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--genome") options.genomePath = value;
+		else if (arg == "--cell-limit") options.cellLimit = std::atoi(value.c_str());
+		else if (arg == "--spawn") options.spawnCount = std::atoi(value.c_str());
+		else if (arg == "--output") options.outputPath = value;
+		else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+		else if (arg == "--backend")
+		{
+			if (value == "gpu") options.useCPU = false;
+			else if (value == "cpu") options.useCPU = true;
+			else
+			{
+				std::cerr << "Unknown backend: " << value << "\n";
+				return false;
+			}
+		}
+		else if (arg == "--context")
+		{
+			if (value == "surfaceless") options.contextPlatform = HeadlessContextPlatform::Surfaceless;
+			else if (value == "device") options.contextPlatform = HeadlessContextPlatform::Device;
+			else
+			{
+				std::cerr << "Unknown context platform: " << value << "\n";
+				return false;
+			}
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << arg << "\n";
+			return false;
+		}
+	}
+
+	if (options.ticks < 0 || options.timeStep <= 0.0f || options.cellLimit <= 0 || options.spawnCount < 0 || options.threads < 0)
+	{
+		std::cerr << "Invalid option value\n";
+		return false;
+	}
+	if (options.cellLimit > config::MAX_CELLS)
+	{
+		options.cellLimit = config::MAX_CELLS;
+	}
+	return true;
+}
+
+static void writeReport(std::ostream& out, const HeadlessOptions& options, const GenomeData& genome,
+						const SimulationBackend& backend, int threads, const SimulationCounts& counts, double wallSeconds)
+{
+	JsonWriter json(out);
+	json.beginObject();
+	json.value("backend", backend.getName());
+	json.value("threads", threads);
+	if (options.useCPU)
+	{
+		json.value("collisionKernel", getCollisionKernelName());
+	}
+	json.value("genome", genome.name);
+	json.value("ticks", options.ticks);
+	json.value("timeStep", options.timeStep);
+	json.value("simulatedSeconds", static_cast<double>(options.ticks) * options.timeStep);
+	json.value("wallSeconds", wallSeconds);
+	json.value("ticksPerSecond", wallSeconds > 0.0 ? options.ticks / wallSeconds : 0.0);
+
+	json.beginObject("counts");
+	json.value("totalCells", counts.totalCells);
+	json.value("liveCells", counts.liveCells);
+	json.value("totalAdhesions", counts.totalAdhesions);
+	json.value("liveAdhesions", counts.liveAdhesions);
+	json.endObject();
+
+	// Sorted by name so reports from different builds diff cleanly
+	std::map<std::string, TimerStats> passes = TimerManager::instance().getTimers();
+	json.beginObject("passes");
+	for (const auto& [name, stats] : passes)
+	{
+		json.beginObject(name.c_str());
+		json.value("samples", stats.tickCount);
+		json.value("totalMs", stats.totalTimeMs);
+		json.value("averageMs", stats.averageTimeMs);
+		json.value("maxMs", stats.maxTimeMs);
+		json.value("lastMs", stats.lastTimeMs);
+		json.endObject();
+	}
+	json.endObject();
+
+	json.endObject();
+	out << "\n";
+}
+
+int main(int argc, char** argv)
+{
+	HeadlessOptions options;
+	if (!parseArgs(argc, argv, options))
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	// With the report on stdout, everything the simulation prints (std::cout) goes to stderr instead, so that
+	// stdout is nothing but the JSON
+	std::ostream reportStdout(std::cout.rdbuf());
+	if (options.outputPath == "-")
+	{
+		std::cout.rdbuf(std::cerr.rdbuf());
+	}
+
+	GenomeData genome;
+	if (!options.genomePath.empty() && !loadGenomeFromFile(genome, options.genomePath))
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (!options.useCPU && !createHeadlessGLContext(options.contextPlatform))
+	{
+		return EXIT_FAILURE;
+	}
+
+	int exitCode = EXIT_SUCCESS;
+	{ // This scope is used to ensure the opengl elements are destroyed before the opengl context
+	std::unique_ptr<SimulationBackend> backend;
+	int threads = 1;
+	if (options.useCPU)
+	{
+		auto cpuBackend = std::make_unique<CPUSimulationBackend>(options.cellLimit, options.threads);
+		threads = cpuBackend->getThreadCount();
+		backend = std::move(cpuBackend);
+	}
+	else
+	{
+		backend = std::make_unique<GPUSimulationBackend>(options.cellLimit);
+	}
+	backend->setGenome(genome);
+
+	ComputeCell initialCell{};
+	initialCell.modeIndex = genome.initialMode;
+	initialCell.orientation = genome.initialOrientation;
+	backend->addCell(initialCell);
+	if (options.spawnCount > 0)
+	{
+		backend->spawnCells(options.spawnCount);
+	}
+	backend->applyPendingCells();
+
+	// Setup costs (shader compilation, initial upload) are not part of the report
+	backend->finish();
+	TimerManager::instance().reset();
+
+	auto start = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < options.ticks; tick++)
+	{
+		backend->step(options.timeStep);
+	}
+	backend->finish();
+	auto end = std::chrono::steady_clock::now();
+	double wallSeconds = std::chrono::duration<double>(end - start).count();
+
+	SimulationCounts counts = backend->getCounts();
+	TimerManager::instance().finalizeFrame();
+
+	if (options.outputPath == "-")
+	{
+		writeReport(reportStdout, options, genome, *backend, threads, counts, wallSeconds);
+	}
+	else
+	{
+		std::ofstream file(options.outputPath);
+		if (file)
+		{
+			writeReport(file, options, genome, *backend, threads, counts, wallSeconds);
+		}
+		else
+		{
+			std::cerr << "Failed to open output file: " << options.outputPath << "\n";
+			exitCode = EXIT_FAILURE;
+		}
+	}
+	}
+
+	if (!options.useCPU)
+	{
+		destroyHeadlessGLContext();
+	}
+	std::cout.rdbuf(reportStdout.rdbuf());
+	return exitCode;
+}
@@ -22,6 +22,7 @@
 
 // Simulation includes
 #include "src/simulation/cell/cell_manager.h"
+#include "src/simulation/backend/simulation_thread.h"
 
 // Rendering includes
 #include "src/rendering/core/shader_class.h"
@@ -234,7 +235,15 @@ void renderFrame(CellManager& previewCellManager, CellManager& mainCellManager,
 	}
 }
 
-void updateSimulation(CellManager& previewCellManager, CellManager& mainCellManager, SceneManager& sceneManager)
+// Simulation time the next tick of the active scene covers: config::physicsTimeStep, or what the scene's
+// adaptive time step controller picks
+float getSimulationTimeStep(CellManager& previewCellManager, CellManager& mainCellManager, SceneManager& sceneManager)
+{
+	CellManager& activeCellManager = sceneManager.getCurrentScene() == Scene::PreviewSimulation ? previewCellManager : mainCellManager;
+	return activeCellManager.getNextTimeStep();
+}
+
+void updateSimulation(CellManager& previewCellManager, CellManager& mainCellManager, SimulationThread& mainSimulationThread, SceneManager& sceneManager, float timeStep)
 {
 	// Only update simulations if not paused
 	if (sceneManager.isPaused())
@@ -242,7 +251,6 @@ void updateSimulation(CellManager& previewCellManager, CellManager& mainCellMana
 		return;
 	}
 	// Update only the active scene simulation
-	float timeStep = config::physicsTimeStep;// *sceneManager.getSimulationSpeed();
 	Scene currentScene = sceneManager.getCurrentScene();
 	
 	try
@@ -256,9 +264,9 @@ void updateSimulation(CellManager& previewCellManager, CellManager& mainCellMana
 			// Update preview simulation time tracking
 			sceneManager.updatePreviewSimulationTime(timeStep);
 		}
-		else if (currentScene == Scene::MainSimulation)
+		else if (currentScene == Scene::MainSimulation && !mainSimulationThread.isRunning())
 		{
-			// Update only Main Simulation
+			// Update only Main Simulation (unless its own thread is simulating it)
 			mainCellManager.updateCells(timeStep);
 			checkGLError("updateCells - main");
 		}
@@ -273,6 +281,25 @@ void updateSimulation(CellManager& previewCellManager, CellManager& mainCellMana
 	}
 }
 
+// Hands the scene controls to the simulation thread and shows its newest state, without ever waiting for it
+void syncSimulationThread(SimulationThread& mainSimulationThread, CellManager& mainCellManager, SceneManager& sceneManager)
+{
+	if (!mainSimulationThread.isRunning())
+	{
+		return;
+	}
+
+	bool mainSceneActive = sceneManager.getCurrentScene() == Scene::MainSimulation;
+	mainSimulationThread.setPaused(sceneManager.isPaused() || !mainSceneActive);
+	mainSimulationThread.setSpeed(sceneManager.getSimulationSpeed());
+
+	if (mainSceneActive && mainSimulationThread.acquireSnapshot())
+	{
+		mainCellManager.presentSnapshot(mainSimulationThread.getSnapshot());
+		checkGLError("presentSnapshot");
+	}
+}
+
 // ImGui rendering
 void renderImGui(const ImGuiIO& io)
 {
@@ -336,6 +363,15 @@ int main()
 	previewCellManager.updateCells(config::physicsTimeStep);
 	mainCellManager.updateCells(config::physicsTimeStep);
 
+	// Optional simulation thread for the main scene (toggled in the scene manager window)
+	SimulationThread mainSimulationThread;
+	uiManager.mainSimulationThread = &mainSimulationThread;
+	if (config::defaultUseSimulationThread)
+	{
+		mainSimulationThread.start();
+		uiManager.resetMainSimulation(mainCellManager);
+	}
+
 	AudioEngine audioEngine;
 	audioEngine.init();
 	audioEngine.start();
@@ -367,7 +403,6 @@ int main()
 		deltaTime = std::clamp(deltaTime, 0.0f, config::maxDeltaTime);
 		accumulator += deltaTime;
 		accumulator = std::clamp(accumulator, 0.0f, config::maxAccumulatorTime);
-		float tickPeriod = config::physicsTimeStep / sceneManager.getSimulationSpeed();//config::physicsSpeed;
 
 		// Check window state first - before any OpenGL operations
 		if (handleWindowStateTransitions(window, windowState))
@@ -418,11 +453,16 @@ int main()
 		processInput(input, previewCamera, mainCamera, previewCellManager, mainCellManager, sceneManager, deltaTime, width, height, synthEngine);
 
 		/// Then we handle cell simulation
-		while (accumulator >= tickPeriod)
+		// Every tick takes its time step out of the accumulator, scaled by the speed; with the adaptive time
+		// step every tick may be a different length
+		float timeStep = getSimulationTimeStep(previewCellManager, mainCellManager, sceneManager);
+		while (accumulator >= timeStep / sceneManager.getSimulationSpeed())
 		{
-			updateSimulation(previewCellManager, mainCellManager, sceneManager);
-			accumulator -= tickPeriod;
+			updateSimulation(previewCellManager, mainCellManager, mainSimulationThread, sceneManager, timeStep);
+			accumulator -= timeStep / sceneManager.getSimulationSpeed();
+			timeStep = getSimulationTimeStep(previewCellManager, mainCellManager, sceneManager);
 		}
+		syncSimulationThread(mainSimulationThread, mainCellManager, sceneManager);
 		/// Then we handle rendering
 		renderFrame(previewCellManager, mainCellManager, previewCamera, mainCamera, uiManager, sphereShader, perfMonitor, sceneManager, width, height);
 
@@ -21,7 +21,7 @@ namespace config
 	// ========== Cell Simulation Configuration ==========
 	constexpr int MAX_CELLS{100000};
 	constexpr int DEFAULT_CELL_COUNT{100000};
-	constexpr int MAX_ADHESIONS_PER_CELL{ 20 }; // Maximum number of adhesions per cell
+	constexpr int MAX_ADHESIONS_PER_CELL{ 20 }; // Average adhesions per cell the connection buffers are sized for (not a per-cell cap)
 	constexpr int MAX_ADHESIONS{ MAX_CELLS * MAX_ADHESIONS_PER_CELL / 2};
 	constexpr float DEFAULT_SPAWN_RADIUS{50.0f};
 	constexpr int COUNTER_NUMBER{ 4 }; // Number of counters in the cell count buffer
@@ -30,8 +30,62 @@ namespace config
 	constexpr float WORLD_SIZE{100.0f};                          // Size of the simulation world (cube from -50 to +50)
 	constexpr int GRID_RESOLUTION{64};                            // Increased from 32 to 64: 64^3 = 262,144 total grid cells for better distribution
 	constexpr float GRID_CELL_SIZE{WORLD_SIZE / GRID_RESOLUTION}; // Size of each grid cell (~1.56 units)
-	constexpr int MAX_CELLS_PER_GRID{32};                         // Reduced from 64 to 32: better memory access patterns
 	constexpr int TOTAL_GRID_CELLS{GRID_RESOLUTION * GRID_RESOLUTION * GRID_RESOLUTION};
+	static_assert((GRID_RESOLUTION & (GRID_RESOLUTION - 1)) == 0 && GRID_RESOLUTION <= 1024, "Morton grid keys need a power of two resolution of at most 10 bits");
+	constexpr int GRID_SCAN_BLOCK_SIZE{1024};                     // Grid counts scanned per work group by grid_prefix_sum.comp
+	constexpr int MAX_GRID_KEYS{GRID_SCAN_BLOCK_SIZE * GRID_SCAN_BLOCK_SIZE}; // The block totals are scanned in a single work group
+	static_assert(TOTAL_GRID_CELLS <= MAX_GRID_KEYS, "Too many grid cells for the two level grid prefix sum");
+	constexpr int GRID_LEVEL_COUNT{4};                            // Levels of the multi-level grid: level l has GRID_RESOLUTION >> l grid cells per axis
+	// First grid key of a level of the multi-level grid: the grid cells of all finer levels come first
+	constexpr int gridLevelKeyOffset(int level)
+	{
+		int offset = 0;
+		for (int l = 0; l < level; l++)
+		{
+			int resolution = GRID_RESOLUTION >> l;
+			offset += resolution * resolution * resolution;
+		}
+		return offset;
+	}
+	constexpr int TOTAL_MULTI_LEVEL_GRID_CELLS{gridLevelKeyOffset(GRID_LEVEL_COUNT)};
+	static_assert((GRID_RESOLUTION >> (GRID_LEVEL_COUNT - 1)) >= 1 && TOTAL_MULTI_LEVEL_GRID_CELLS <= MAX_GRID_KEYS, "Too many grid levels");
+	constexpr int GRID_HASH_BUCKETS_PER_CELL{2};                  // Hashed grid table size per cell of capacity (rounded up to a power of two)
+
+	// ========== GPU Pipeline Configuration ==========
+	constexpr bool defaultUseFusedPhysics{true};              // Compute collision forces and integrate in one pass by default
+	constexpr bool defaultUseHashedGrid{false};               // Hashed sparse grid and no world walls instead of the dense 64^3 grid
+	constexpr bool defaultUseMultiLevelGrid{false};           // Dense grid levels at power of two cell sizes, each cell in the level matching its size
+	constexpr int defaultMortonReorderInterval{128};          // Ticks between sorting cell storage by Morton order (0 = never)
+	constexpr int defaultCellCompactionInterval{64};          // Ticks between compacting dead cells out of cell storage (0 = only before a reorder)
+	constexpr bool defaultUseNeighborLists{false};            // Collide against Verlet neighbour lists, rebuilding the grid only when they go stale
+	constexpr float defaultNeighborListSkin{0.5f};            // Distance beyond contact kept on the lists; rebuilt once a cell may have moved half of it
+	constexpr int defaultNeighborListMaxAge{10};              // Rebuild the lists at least this often (ticks)
+	constexpr int NEIGHBOR_LIST_INITIAL_CAPACITY_PER_CELL{32}; // Neighbour index buffer size per cell of capacity, doubled on overflow
+	constexpr float NEIGHBOR_LIST_LEAD_TICKS{2.0f};           // Ticks the displacement check extrapolates over, to cover its readback latency
+	constexpr bool defaultUseSimulationThread{false};         // Simulate the main scene with the CPU backend on its own thread, apart from rendering
+	constexpr float SIMULATION_SNAPSHOT_INTERVAL{1.0f / 120.0f}; // Shortest time between render snapshots of the simulation thread (seconds)
+	// How the update passes integrate velocity and position (u_integrator in cell_update.comp and cell_physics_fused.comp)
+	enum class Integrator : int
+	{
+		Euler = 0,          // Symplectic Euler, damping applied as a factor (the original update)
+		VelocityVerlet = 1, // Half kicks on either side of every drift, with the last tick's acceleration carried over
+		SemiImplicit = 2,   // Damping and contact stiffness taken implicitly, stable at much longer steps
+	};
+	constexpr Integrator defaultIntegrator{Integrator::Euler};
+	constexpr const char* INTEGRATOR_NAMES[]{"euler", "verlet", "semi-implicit"};
+	constexpr bool defaultUseAdaptiveTimeStep{false};         // Pick every tick's time step from the fastest, most accelerated and most overlapping cells
+	constexpr float ADAPTIVE_TIME_STEP_MIN{0.0025f};          // Bounds of the adaptive time step (simulation seconds); ticks that land on a split may be shorter
+	constexpr float ADAPTIVE_TIME_STEP_MAX{0.05f};
+	constexpr float ADAPTIVE_MAX_DISPLACEMENT{0.05f};         // Furthest any cell may move in one tick (world units)
+	constexpr float ADAPTIVE_MAX_OVERLAP{0.2f};               // Deepest overlap (fraction of the contact distance) before the step shrinks
+	constexpr float ADAPTIVE_TIME_STEP_GROWTH{1.25f};         // Largest growth of the step from one tick to the next
+	constexpr int ADAPTIVE_TIME_STEP_HISTORY{256};            // Ticks a statistics readback may lag behind and still be used
+	constexpr bool defaultUseSleeping{false};                 // Skip physics and integration for cells that have come to rest
+	constexpr int SLEEP_TICKS{30};                            // Consecutive quiet ticks before a cell falls asleep
+	constexpr float SLEEP_SPEED{0.05f};                       // Below this speed a cell is quiet; an awake cell this fast wakes the sleepers it touches
+	constexpr float SLEEP_ACCELERATION{0.5f};                 // Below this acceleration (net force over mass) a cell is quiet
+	constexpr float SLEEP_WAKE_BEFORE_SPLIT{0.1f};            // Simulation time before its split at which a sleeping cell wakes up
+	constexpr int DIVISION_WHEEL_SLOTS{255};                  // Most time slots of the division timing wheel per epoch (one more collects the later splits)
 
 	// ========== Rendering Configuration ==========
 	// Distance-based culling and fading parameters
@@ -0,0 +1,104 @@
+#include "camera.h"
+#include "../../input/input.h"
+#include <GLFW/glfw3.h>
+
+// Keyboard and mouse controls, kept apart from camera.cpp so the headless tools can use the camera without
+// linking GLFW
+void Camera::processInput(Input &input, float deltaTime)
+{
+    // Calculate movement speed (with sprint modifier)
+    float velocity = moveSpeed * deltaTime;
+    if (input.isKeyPressed(GLFW_KEY_LEFT_SHIFT))
+        velocity *= sprintMultiplier;
+
+    // Handle mouse input for camera rotation (Space Engineers style)
+    static bool wasRightMousePressed = false;
+    bool isRightMousePressed = input.isMouseButtonPressed(GLFW_MOUSE_BUTTON_RIGHT);
+    
+    if (isRightMousePressed && !wasRightMousePressed)
+    {
+        // Start dragging
+        isDragging = true;
+        lastMousePos = input.getMousePosition(false);
+        glfwSetInputMode(input.getWindow(), GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    }
+    else if (!isRightMousePressed && wasRightMousePressed)
+    {
+        // Stop dragging
+        isDragging = false;
+        glfwSetInputMode(input.getWindow(), GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    }
+
+    if (isDragging)
+    {
+        glm::vec2 currentMousePos = input.getMousePosition(false);
+        glm::vec2 mouseOffset = currentMousePos - lastMousePos;
+        lastMousePos = currentMousePos;
+
+        processMouseMovement(mouseOffset.x, mouseOffset.y);
+    }
+
+    wasRightMousePressed = isRightMousePressed;
+
+    // Roll controls (Q and E for camera roll around forward vector)
+    float rollSpeed = 90.0f * deltaTime; // 90 degrees per second
+    if (input.isKeyPressed(GLFW_KEY_Q))
+    {
+        roll += rollSpeed;
+        // Apply roll rotation directly to right and up vectors
+        float rollRad = glm::radians(rollSpeed);
+        float cosRoll = cos(rollRad);
+        float sinRoll = sin(rollRad);
+        
+        glm::vec3 oldRight = right;
+        right = right * cosRoll + up * sinRoll;
+        up = up * cosRoll - oldRight * sinRoll;
+    }
+    if (input.isKeyPressed(GLFW_KEY_E))
+    {
+        roll -= rollSpeed;
+        // Apply roll rotation directly to right and up vectors
+        float rollRad = glm::radians(-rollSpeed);
+        float cosRoll = cos(rollRad);
+        float sinRoll = sin(rollRad);
+        
+        glm::vec3 oldRight = right;
+        right = right * cosRoll + up * sinRoll;
+        up = up * cosRoll - oldRight * sinRoll;
+    }
+
+    // Handle mouse scroll for zoom (Space Engineers style)
+    if (input.hasScrollInput())
+    {
+        float scrollDelta = input.getScrollDelta();
+        processMouseScroll(scrollDelta);
+    }
+
+    // Movement controls (Space Engineers style - all movement relative to camera orientation)
+    // WASD for forward/back/left/right, Space/C for up/down relative to camera view
+    glm::vec3 moveDirection(0.0f);
+
+    // Forward/backward movement (W/S) - relative to camera's forward direction
+    if (input.isKeyPressed(GLFW_KEY_W))
+        moveDirection += front;
+    if (input.isKeyPressed(GLFW_KEY_S))
+        moveDirection -= front;
+
+    // Left/right movement (A/D) - relative to camera's right direction
+    if (input.isKeyPressed(GLFW_KEY_A))
+        moveDirection -= right;
+    if (input.isKeyPressed(GLFW_KEY_D))
+        moveDirection += right;
+
+    // Up/down movement (Space/C) - relative to camera's up direction
+    if (input.isKeyPressed(GLFW_KEY_SPACE))
+        moveDirection += up;
+    if (input.isKeyPressed(GLFW_KEY_C))
+        moveDirection -= up;
+
+    // Apply movement
+    if (glm::length(moveDirection) > 0.0f)
+    {
+        position += glm::normalize(moveDirection) * velocity;
+    }
+}
@@ -80,6 +80,26 @@ GLFWwindow *createWindow()
     return window;
 }
 
+GLFWwindow *createHeadlessContext()
+{
+    // Never map the window, we only render into offscreen buffers
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow *window = glfwCreateWindow(1, 1, config::APPLICATION_NAME, NULL, NULL);
+    if (window == NULL)
+    {
+        std::cout << "Failed to create headless GL context\n";
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+    glfwMakeContextCurrent(window);
+
+    // Nothing is ever presented, don't let swaps throttle the run
+    glfwSwapInterval(0);
+
+    return window;
+}
+
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
     glViewport(0, 0, width, height);
@@ -7,6 +7,9 @@ void initGLFW();
 
 GLFWwindow* createWindow();
 
+// Hidden 1x1 window whose only purpose is to own a GL context (headless tools on Windows, see headless_context.h)
+GLFWwindow* createHeadlessContext();
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 
 void APIENTRY glDebugOutput(GLenum source, GLenum type, unsigned int id, GLenum severity,
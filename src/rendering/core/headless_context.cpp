@@ -0,0 +1,125 @@
+#include "headless_context.h"
+#include <glad/glad.h>
+#include <iostream>
+#include "../../core/config.h"
+
+#ifdef _WIN32
+
+#include <GLFW/glfw3.h>
+#include "glfw_helpers.h"
+#include "glad_helpers.h"
+
+static GLFWwindow* headlessWindow = nullptr;
+
+bool createHeadlessGLContext(HeadlessContextPlatform)
+{
+    glfwSetErrorCallback([](int error, const char* description)
+    {
+        std::cerr << "GLFW Error " << error << ": " << description << "\n";
+    });
+    initGLFW();
+    headlessWindow = createHeadlessContext();
+    initGLAD(headlessWindow);
+    setupGLFWDebugFlags();
+    return true;
+}
+
+void destroyHeadlessGLContext()
+{
+    if (headlessWindow)
+    {
+        glfwDestroyWindow(headlessWindow);
+        glfwTerminate();
+        headlessWindow = nullptr;
+    }
+}
+
+#else
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+static EGLDisplay headlessDisplay = EGL_NO_DISPLAY;
+static EGLContext headlessContext = EGL_NO_CONTEXT;
+
+static bool failHeadlessContext(const char* step)
+{
+    std::cerr << "Failed to create headless GL context: " << step << " (EGL error 0x" << std::hex << eglGetError()
+              << std::dec << ")\n";
+    destroyHeadlessGLContext();
+    return false;
+}
+
+static EGLDisplay getHeadlessDisplay(HeadlessContextPlatform platform)
+{
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!getPlatformDisplay)
+        return EGL_NO_DISPLAY;
+
+    if (platform == HeadlessContextPlatform::Surfaceless)
+        return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+
+    auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    EGLDeviceEXT device = EGL_NO_DEVICE_EXT;
+    EGLint deviceCount = 0;
+    if (!queryDevices || !queryDevices(1, &device, &deviceCount) || deviceCount == 0)
+        return EGL_NO_DISPLAY;
+    return getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+}
+
+bool createHeadlessGLContext(HeadlessContextPlatform platform)
+{
+    headlessDisplay = getHeadlessDisplay(platform);
+    if (headlessDisplay == EGL_NO_DISPLAY)
+        return failHeadlessContext("no EGL display for this platform");
+
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(headlessDisplay, &major, &minor))
+        return failHeadlessContext("eglInitialize");
+    if (!eglBindAPI(EGL_OPENGL_API))
+        return failHeadlessContext("eglBindAPI");
+
+    // The configured version first, then 4.5, the oldest with everything the simulation uses (DSA) and what
+    // llvmpipe offers
+    const EGLint versions[][2] = { { config::OPENGL_VERSION_MAJOR, config::OPENGL_VERSION_MINOR }, { 4, 5 } };
+    for (const auto& version : versions)
+    {
+        const EGLint attributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, version[0],
+            EGL_CONTEXT_MINOR_VERSION, version[1],
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#ifndef NDEBUG
+            EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif
+            EGL_NONE
+        };
+        headlessContext = eglCreateContext(headlessDisplay, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+        if (headlessContext != EGL_NO_CONTEXT)
+            break;
+    }
+    if (headlessContext == EGL_NO_CONTEXT)
+        return failHeadlessContext("eglCreateContext");
+    if (!eglMakeCurrent(headlessDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, headlessContext))
+        return failHeadlessContext("eglMakeCurrent");
+
+    int version = gladLoadGL(reinterpret_cast<GLADloadfunc>(eglGetProcAddress));
+    if (!version)
+        return failHeadlessContext("gladLoadGL");
+    std::cerr << "GL " << GLAD_VERSION_MAJOR(version) << "." << GLAD_VERSION_MINOR(version) << " (EGL " << major << "."
+              << minor << ", " << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << ")\n";
+    return true;
+}
+
+void destroyHeadlessGLContext()
+{
+    if (headlessDisplay == EGL_NO_DISPLAY)
+        return;
+    eglMakeCurrent(headlessDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (headlessContext != EGL_NO_CONTEXT)
+        eglDestroyContext(headlessDisplay, headlessContext);
+    eglTerminate(headlessDisplay);
+    headlessContext = EGL_NO_CONTEXT;
+    headlessDisplay = EGL_NO_DISPLAY;
+}
+
+#endif
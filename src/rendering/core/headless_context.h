@@ -0,0 +1,17 @@
+#pragma once
+
+// GL context for the headless tools (biospheres_headless, biospheres_bench), with GLAD loaded.
+// On Linux it is an EGL context without any surface or config (EGL_KHR_no_config_context), so it needs
+// neither a display server nor GLFW: Mesa's surfaceless platform (llvmpipe on GPU-less nodes) or the first
+// EGL device. Everything is drawn into framebuffer objects. On Windows, where desktop GL has no EGL, it is
+// a hidden GLFW window, and the platform is ignored.
+enum class HeadlessContextPlatform
+{
+    Surfaceless, // EGL_PLATFORM_SURFACELESS_MESA
+    Device       // EGL_PLATFORM_DEVICE_EXT, the first device
+};
+
+// Creates the context, makes it current and loads GLAD; false (with a message on stderr) on failure
+bool createHeadlessGLContext(HeadlessContextPlatform platform);
+
+void destroyHeadlessGLContext();
@@ -349,6 +349,16 @@ void SphereMesh::renderLOD(int lodLevel, int instanceCount, int instanceOffset)
     glBindVertexArray(0);
 }
 
+void SphereMesh::renderLODIndirect(int lodLevel, GLuint commandBuffer, GLintptr commandOffset) const {
+    if (lodLevel < 0 || lodLevel >= LOD_LEVELS || VAO[lodLevel] == 0 || indexCount[lodLevel] == 0) return;
+
+    glBindVertexArray(VAO[lodLevel]);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(commandOffset));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
 void SphereMesh::cleanup() {
     for (int lod = 0; lod < LOD_LEVELS; lod++) {
         if (EBO[lod] != 0) {
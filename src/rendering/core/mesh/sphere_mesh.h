@@ -39,6 +39,7 @@ public:
     void setupLODInstanceBufferWithFade(int lodLevel, GLuint lodInstanceDataBuffer); // Setup LOD instance buffer with fade factor
     void render(int instanceCount) const;
     void renderLOD(int lodLevel, int instanceCount, int instanceOffset = 0) const; // Render specific LOD level
+    void renderLODIndirect(int lodLevel, GLuint commandBuffer, GLintptr commandOffset) const; // Instance count from a GPU written draw command
     void cleanup();
     
     int getIndexCount() const { return indexCount[0]; }
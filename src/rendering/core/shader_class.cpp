@@ -78,6 +78,7 @@ Shader::Shader(const char* vertexFile, const char* fragmentFile)
 	glLinkProgram(ID);
 	// Print linking errors if any
 	glGetProgramiv(ID, GL_LINK_STATUS, &success);
+	linked = success != 0;
 	if (!success)
 	{
 		glGetProgramInfoLog(ID, 512, NULL, infoLog);
@@ -122,6 +123,7 @@ Shader::Shader(const char* computeFile)
 	glLinkProgram(ID);
 	// Print linking errors if any
 	glGetProgramiv(ID, GL_LINK_STATUS, &success);
+	linked = success != 0;
 	if (!success)
 	{
 		glGetProgramInfoLog(ID, 512, NULL, infoLog);
@@ -150,6 +152,12 @@ void Shader::dispatch(GLuint num_groups_x, GLuint num_groups_y, GLuint num_group
 	glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
 }
 
+// Dispatch compute shader with GPU-written work group counts
+void Shader::dispatchIndirect(GLintptr offset)
+{
+	glDispatchComputeIndirect(offset);
+}
+
 // utility uniform functions
 
 void Shader::setInt(const std::string& name, int value) const
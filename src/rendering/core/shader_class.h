@@ -18,12 +18,16 @@ public:
 	Shader(const char* computeFile);
 	//~Shader() { destroy(); }
 	
+	// Whether the program linked; a failed one does nothing when used
+	bool isLinked() const { return linked; }
 	// Activates the Shader Program
 	void use();
 	// Deletes the Shader Program
 	void destroy();
 	// Dispatch compute shader
-	void dispatch(GLuint num_groups_x, GLuint num_groups_y = 1, GLuint num_groups_z = 1);	// utility uniform functions
+	void dispatch(GLuint num_groups_x, GLuint num_groups_y = 1, GLuint num_groups_z = 1);
+	// Dispatch compute shader with the work group counts at offset in the bound GL_DISPATCH_INDIRECT_BUFFER
+	void dispatchIndirect(GLintptr offset);	// utility uniform functions
 	//void setBool(const std::string& name, bool value) const; // Apparently I can't do that?!?
 	void setInt(const std::string& name, int value) const;
 	void setFloat(const std::string& name, float value) const;
@@ -35,4 +39,6 @@ public:
 	void setVec4(const std::string& name, float x, float y, float z, float w) const;
 	void setMat4(const std::string& name, const glm::mat4& matrix) const;
 
+private:
+	bool linked = false;
 };
\ No newline at end of file
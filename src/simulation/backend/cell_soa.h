@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "../cell/common_structs.h"
+
+// Structure-of-arrays copy of the ComputeCell physics fields
+// One contiguous float stream per component, so passes that only need positions or velocities
+// stream through 4-byte values instead of 208-byte records (and SIMD loads are plain vector loads).
+struct CellSoA
+{
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> mass;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> accX, accY, accZ;
+    std::vector<float> stiffness;         // Contact stiffness over mass from physics (acceleration.w on the GPU)
+    std::vector<float> carriedAccX, carriedAccY, carriedAccZ; // Velocity Verlet: acceleration of the last update
+    std::vector<float> carried;           // 1 where the last update carried one (the stamp on the GPU), else 0
+
+    int size() const { return static_cast<int>(posX.size()); }
+
+    void reserve(int count)
+    {
+        for (std::vector<float>* stream : streams()) stream->reserve(count);
+    }
+
+    void clear()
+    {
+        for (std::vector<float>* stream : streams()) stream->clear();
+    }
+
+    void push(const ComputeCell& cell)
+    {
+        posX.push_back(cell.positionAndMass.x);
+        posY.push_back(cell.positionAndMass.y);
+        posZ.push_back(cell.positionAndMass.z);
+        mass.push_back(cell.positionAndMass.w);
+        velX.push_back(cell.velocity.x);
+        velY.push_back(cell.velocity.y);
+        velZ.push_back(cell.velocity.z);
+        accX.push_back(cell.acceleration.x);
+        accY.push_back(cell.acceleration.y);
+        accZ.push_back(cell.acceleration.z);
+        stiffness.push_back(cell.acceleration.w);
+        carriedAccX.push_back(0.0f);
+        carriedAccY.push_back(0.0f);
+        carriedAccZ.push_back(0.0f);
+        carried.push_back(0.0f);
+    }
+
+    // Append a copy of an existing entry and return its index
+    int pushCopy(int index)
+    {
+        for (std::vector<float>* stream : streams())
+        {
+            float value = (*stream)[index];
+            stream->push_back(value);
+        }
+        return size() - 1;
+    }
+
+    // Overwrite entry to with a copy of entry from
+    void copy(int from, int to)
+    {
+        for (std::vector<float>* stream : streams()) (*stream)[to] = (*stream)[from];
+    }
+
+    // Reorder every stream so that entry i becomes the old entry order[i]; the streams end up order.size()
+    // long, so a compaction can leave entries out
+    void permute(const std::vector<uint32_t>& order)
+    {
+        std::vector<float> reordered;
+        for (std::vector<float>* stream : streams())
+        {
+            reordered.resize(order.size());
+            for (size_t i = 0; i < order.size(); i++)
+            {
+                reordered[i] = (*stream)[order[i]];
+            }
+            stream->swap(reordered);
+        }
+    }
+
+    glm::vec3 position(int index) const { return glm::vec3(posX[index], posY[index], posZ[index]); }
+
+    void setPosition(int index, const glm::vec3& position)
+    {
+        posX[index] = position.x;
+        posY[index] = position.y;
+        posZ[index] = position.z;
+    }
+
+    // Write the physics fields back into a ComputeCell record
+    void store(int index, ComputeCell& cell) const
+    {
+        cell.positionAndMass = glm::vec4(posX[index], posY[index], posZ[index], mass[index]);
+        cell.velocity = glm::vec4(velX[index], velY[index], velZ[index], cell.velocity.w);
+        cell.acceleration = glm::vec4(accX[index], accY[index], accZ[index], stiffness[index]);
+    }
+
+private:
+    std::vector<std::vector<float>*> streams()
+    {
+        return { &posX, &posY, &posZ, &mass, &velX, &velY, &velZ, &accX, &accY, &accZ, &stiffness,
+            &carriedAccX, &carriedAccY, &carriedAccZ, &carried };
+    }
+};
@@ -0,0 +1,144 @@
+#include "collision_kernel.h"
+#include <cmath>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Same constants cell_physics_spatial.comp hardcodes
+static constexpr float COLLISION_STIFFNESS = 100.0f;
+static constexpr float MIN_DISTANCE = 0.001f;
+
+// Every variant evaluates force = delta * (overlap * stiffness / distance); they only differ in
+// summation order and FMA rounding
+
+#if defined(__AVX512F__)
+
+const char* getCollisionKernelName() { return "avx512"; }
+
+glm::vec3 accumulateCollisionForce(const float* x, const float* y, const float* z, const float* radius, int count,
+                                   const glm::vec3& position, float myRadius, float& contactStiffness)
+{
+    const __m512 px = _mm512_set1_ps(position.x);
+    const __m512 py = _mm512_set1_ps(position.y);
+    const __m512 pz = _mm512_set1_ps(position.z);
+    const __m512 pr = _mm512_set1_ps(myRadius);
+    const __m512 minDistance = _mm512_set1_ps(MIN_DISTANCE);
+    const __m512 stiffness = _mm512_set1_ps(COLLISION_STIFFNESS);
+
+    __m512 fx = _mm512_setzero_ps();
+    __m512 fy = _mm512_setzero_ps();
+    __m512 fz = _mm512_setzero_ps();
+    __m512 k = _mm512_setzero_ps();
+
+    for (int i = 0; i < count; i += 16)
+    {
+        int remaining = count - i;
+        __mmask16 lanes = remaining >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1u << remaining) - 1u);
+
+        __m512 dx = _mm512_sub_ps(px, _mm512_maskz_loadu_ps(lanes, x + i));
+        __m512 dy = _mm512_sub_ps(py, _mm512_maskz_loadu_ps(lanes, y + i));
+        __m512 dz = _mm512_sub_ps(pz, _mm512_maskz_loadu_ps(lanes, z + i));
+        __m512 contact = _mm512_add_ps(pr, _mm512_maskz_loadu_ps(lanes, radius + i));
+
+        __m512 distance = _mm512_sqrt_ps(_mm512_fmadd_ps(dx, dx, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dz, dz))));
+
+        __mmask16 hit = lanes;
+        hit = _mm512_mask_cmp_ps_mask(hit, distance, contact, _CMP_LT_OQ);
+        hit = _mm512_mask_cmp_ps_mask(hit, distance, minDistance, _CMP_GT_OQ);
+        if (hit == 0) continue;
+
+        __m512 scale = _mm512_div_ps(_mm512_mul_ps(_mm512_sub_ps(contact, distance), stiffness), distance);
+        fx = _mm512_mask3_fmadd_ps(dx, scale, fx, hit);
+        fy = _mm512_mask3_fmadd_ps(dy, scale, fy, hit);
+        fz = _mm512_mask3_fmadd_ps(dz, scale, fz, hit);
+        k = _mm512_mask_add_ps(k, hit, k, stiffness);
+    }
+
+    contactStiffness += _mm512_reduce_add_ps(k);
+    return glm::vec3(_mm512_reduce_add_ps(fx), _mm512_reduce_add_ps(fy), _mm512_reduce_add_ps(fz));
+}
+
+#elif defined(__AVX2__)
+
+const char* getCollisionKernelName() { return "avx2"; }
+
+static float horizontalSum(__m256 v)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+    return _mm_cvtss_f32(sum);
+}
+
+glm::vec3 accumulateCollisionForce(const float* x, const float* y, const float* z, const float* radius, int count,
+                                   const glm::vec3& position, float myRadius, float& contactStiffness)
+{
+    const __m256 px = _mm256_set1_ps(position.x);
+    const __m256 py = _mm256_set1_ps(position.y);
+    const __m256 pz = _mm256_set1_ps(position.z);
+    const __m256 pr = _mm256_set1_ps(myRadius);
+    const __m256 minDistance = _mm256_set1_ps(MIN_DISTANCE);
+    const __m256 stiffness = _mm256_set1_ps(COLLISION_STIFFNESS);
+    const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    __m256 fx = _mm256_setzero_ps();
+    __m256 fy = _mm256_setzero_ps();
+    __m256 fz = _mm256_setzero_ps();
+    __m256 k = _mm256_setzero_ps();
+
+    for (int i = 0; i < count; i += 8)
+    {
+        // Lanes past the end of the run load zeros and are masked off below
+        __m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(count - i), laneIndex);
+
+        __m256 dx = _mm256_sub_ps(px, _mm256_maskload_ps(x + i, lanes));
+        __m256 dy = _mm256_sub_ps(py, _mm256_maskload_ps(y + i, lanes));
+        __m256 dz = _mm256_sub_ps(pz, _mm256_maskload_ps(z + i, lanes));
+        __m256 contact = _mm256_add_ps(pr, _mm256_maskload_ps(radius + i, lanes));
+
+        __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx),
+            _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz))));
+
+        __m256 hit = _mm256_castsi256_ps(lanes);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(distance, contact, _CMP_LT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(distance, minDistance, _CMP_GT_OQ));
+        if (_mm256_movemask_ps(hit) == 0) continue;
+
+        // Masked-off lanes may hold inf/NaN (distance 0), the and clears them
+        __m256 scale = _mm256_and_ps(hit,
+            _mm256_div_ps(_mm256_mul_ps(_mm256_sub_ps(contact, distance), stiffness), distance));
+        fx = _mm256_add_ps(fx, _mm256_mul_ps(dx, scale));
+        fy = _mm256_add_ps(fy, _mm256_mul_ps(dy, scale));
+        fz = _mm256_add_ps(fz, _mm256_mul_ps(dz, scale));
+        k = _mm256_add_ps(k, _mm256_and_ps(hit, stiffness));
+    }
+
+    contactStiffness += horizontalSum(k);
+    return glm::vec3(horizontalSum(fx), horizontalSum(fy), horizontalSum(fz));
+}
+
+#else
+
+const char* getCollisionKernelName() { return "scalar"; }
+
+glm::vec3 accumulateCollisionForce(const float* x, const float* y, const float* z, const float* radius, int count,
+                                   const glm::vec3& position, float myRadius, float& contactStiffness)
+{
+    glm::vec3 force(0.0f);
+    for (int i = 0; i < count; i++)
+    {
+        glm::vec3 delta = position - glm::vec3(x[i], y[i], z[i]);
+        float distance = std::sqrt(glm::dot(delta, delta));
+        float contact = myRadius + radius[i];
+
+        if (distance < contact && distance > MIN_DISTANCE)
+        {
+            force += delta * ((contact - distance) * COLLISION_STIFFNESS / distance);
+            contactStiffness += COLLISION_STIFFNESS;
+        }
+    }
+    return force;
+}
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Repulsion from cell_physics_spatial.comp against a contiguous run of neighbours
+// x/y/z/radius are parallel streams of `count` neighbours (one grid cell of the grid-sorted SoA).
+// Adds direction * overlap * stiffness for every neighbour that overlaps `position` and returns
+// the accumulated force. Self-pairs are skipped by the same distance > 0.001 test the shader uses.
+// The stiffness of every such contact is added to contactStiffness (for the semi-implicit integrator).
+//
+// Compiled for the widest instruction set the build enables: AVX-512 (16 pairs per step),
+// AVX2 (8 pairs per step) or plain scalar code.
+glm::vec3 accumulateCollisionForce(const float* x, const float* y, const float* z, const float* radius, int count,
+                                   const glm::vec3& position, float myRadius, float& contactStiffness);
+
+// "avx512", "avx2" or "scalar", for reports
+const char* getCollisionKernelName();
@@ -0,0 +1,915 @@
+#include "cpu_backend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <glm/gtc/quaternion.hpp>
+
+#include "collision_kernel.h"
+#include "../cell/genome_io.h"
+#include "../../utils/timer.h"
+
+// ============================================================================
+// SHADER HELPERS
+// ============================================================================
+// Straight ports of the GLSL helpers so both backends make the same decisions
+
+static glm::ivec3 worldToLevelGrid(const glm::vec3& worldPos, int level)
+{
+    const int levelResolution = config::GRID_RESOLUTION >> level;
+    glm::vec3 clampedPos = glm::clamp(worldPos, glm::vec3(-config::WORLD_SIZE * 0.5f), glm::vec3(config::WORLD_SIZE * 0.5f));
+    glm::vec3 normalizedPos = (clampedPos + config::WORLD_SIZE * 0.5f) / config::WORLD_SIZE;
+    glm::ivec3 gridPos = glm::ivec3(normalizedPos * static_cast<float>(levelResolution));
+    return glm::clamp(gridPos, glm::ivec3(0), glm::ivec3(levelResolution - 1));
+}
+
+static glm::ivec3 worldToGrid(const glm::vec3& worldPos)
+{
+    return worldToLevelGrid(worldPos, 0);
+}
+
+static uint32_t levelGridToIndex(const glm::ivec3& gridPos, int level)
+{
+    const int levelResolution = config::GRID_RESOLUTION >> level;
+    return static_cast<uint32_t>(config::gridLevelKeyOffset(level) + gridPos.x +
+        (gridPos.y + gridPos.z * levelResolution) * levelResolution);
+}
+
+static int gridLevelForRadius(float radius, int levelCount)
+{
+    int level = 0;
+    while (level < levelCount - 1 && config::GRID_CELL_SIZE * static_cast<float>(1 << level) < 2.0f * radius)
+    {
+        level++;
+    }
+    return level;
+}
+
+// Z-order index of a dense grid cell, as in grid_assign.comp
+static uint32_t spreadBits(uint32_t v)
+{
+    v &= 0x3ffu;
+    v = (v | (v << 16)) & 0x030000FFu;
+    v = (v | (v << 8)) & 0x0300F00Fu;
+    v = (v | (v << 4)) & 0x030C30C3u;
+    v = (v | (v << 2)) & 0x09249249u;
+    return v;
+}
+
+static uint32_t gridToMortonIndex(const glm::ivec3& gridPos)
+{
+    return spreadBits(static_cast<uint32_t>(gridPos.x)) | (spreadBits(static_cast<uint32_t>(gridPos.y)) << 1) |
+        (spreadBits(static_cast<uint32_t>(gridPos.z)) << 2);
+}
+
+static float hash11(uint32_t n)
+{
+    n = (n ^ 61u) ^ (n >> 16u);
+    n *= 9u;
+    n = n ^ (n >> 4u);
+    n *= 0x27d4eb2du;
+    n = n ^ (n >> 15u);
+    return static_cast<float>(n & 0x00FFFFFFu) / static_cast<float>(0x01000000u);
+}
+
+// A mode whose lifespan is shorter than its split interval dies at that age instead (see cell_death.cpp)
+static bool diesBeforeSplit(const GPUMode& mode)
+{
+    return mode.lifespan > 0.0f && mode.lifespan < mode.splitInterval;
+}
+
+// Time from birth to the split, or to the death
+static float getSplitInterval(const GPUMode& mode)
+{
+    return diesBeforeSplit(mode) ? mode.lifespan : mode.splitInterval;
+}
+
+static glm::quat smallRandomQuat(float angle, uint32_t seed)
+{
+    glm::vec3 axis = glm::normalize(glm::vec3(
+        hash11(seed * 3u + 0u),
+        hash11(seed * 3u + 1u),
+        hash11(seed * 3u + 2u)) * 2.0f - 1.0f);
+    float halfAngle = angle * 0.5f;
+    return glm::normalize(glm::quat(std::cos(halfAngle), axis * std::sin(halfAngle)));
+}
+
+static glm::vec3 rotateVectorByQuaternion(const glm::vec3& v, const glm::quat& q)
+{
+    glm::vec3 u(q.x, q.y, q.z);
+    float s = q.w;
+    return 2.0f * glm::dot(u, v) * u
+        + (s * s - glm::dot(u, u)) * v
+        + 2.0f * s * glm::cross(u, v);
+}
+
+// Same constants the GPU path passes as uniforms or hardcodes in the shaders
+static constexpr float DAMPING = 0.98f;
+static constexpr float BOUNDS = 50.0f;
+static constexpr uint32_t NOT_IN_GRID = 0xFFFFFFFFu; // Grid index of a dead cell
+
+// ============================================================================
+// CONSTRUCTOR & CELL MANAGEMENT
+// ============================================================================
+
+CPUSimulationBackend::CPUSimulationBackend(int cellLimit, int threadCount)
+    : jobs(threadCount)
+    , cellLimit(cellLimit)
+    , adhesionLimit(cellLimit * config::MAX_ADHESIONS_PER_CELL / 2)
+{
+    gridCounts.resize(config::TOTAL_MULTI_LEVEL_GRID_CELLS);
+    gridStart.resize(config::TOTAL_MULTI_LEVEL_GRID_CELLS);
+    occupiedGridCells.reserve(std::min(cellLimit, config::TOTAL_MULTI_LEVEL_GRID_CELLS));
+    cells.reserve(cellLimit);
+    birthTimes.reserve(cellLimit);
+    physics.reserve(cellLimit);
+
+    // Usable before setGenome(), like CellManager with an untouched mode buffer
+    setGenome(GenomeData());
+}
+
+void CPUSimulationBackend::setGenome(const GenomeData& genome)
+{
+    modes = buildGPUModes(genome);
+
+    // Bounds the division epoch, as in CellManager::setGenome()
+    divisionMinSplitInterval = 0.0f;
+    for (const GPUMode& mode : modes)
+    {
+        float interval = getSplitInterval(mode);
+        if (divisionMinSplitInterval == 0.0f || interval < divisionMinSplitInterval)
+            divisionMinSplitInterval = interval;
+    }
+    divisionScheduleDirty = true;
+}
+
+void CPUSimulationBackend::addCell(const ComputeCell& cell)
+{
+    if (static_cast<int>(cells.size() + pendingCells.size()) + 1 > cellLimit)
+    {
+        std::cout << "Warning: Maximum cell count reached!\n";
+        return;
+    }
+
+    ComputeCell correctedCell = cell;
+    correctedCell.positionAndMass.w = 1.0f; // Same as CellManager::addCellToStagingBuffer
+    pendingCells.push_back(correctedCell);
+}
+
+void CPUSimulationBackend::spawnCells(int count)
+{
+    TimerCPU cpuTimer("Spawning Cells");
+
+    for (int i = 0; i < count; ++i)
+    {
+        float angle1 = static_cast<float>(rand()) / RAND_MAX * 2.0f * 3.14159f;
+        float angle2 = static_cast<float>(rand()) / RAND_MAX * 3.14159f;
+        float radius = static_cast<float>(rand()) / RAND_MAX * spawnRadius;
+
+        glm::vec3 position = glm::vec3(
+            radius * sin(angle2) * cos(angle1),
+            radius * cos(angle2),
+            radius * sin(angle2) * sin(angle1));
+
+        glm::vec3 velocity = glm::vec3(
+            (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 5.0f,
+            (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 5.0f,
+            (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 5.0f);
+
+        ComputeCell newCell{};
+        newCell.positionAndMass = glm::vec4(position, 1.);
+        newCell.velocity = glm::vec4(velocity, 0.);
+        addCell(newCell);
+    }
+}
+
+void CPUSimulationBackend::applyPendingCells()
+{
+    if (pendingCells.empty()) return;
+    TimerCPU timer("Cell Additions");
+
+    const float divisionClock = getDivisionClock();
+    for (const ComputeCell& cell : pendingCells)
+    {
+        if (static_cast<int>(cells.size()) >= cellLimit) break;
+        cells.push_back(cell);
+        birthTimes.push_back(divisionClock - cell.age); // apply_additions.comp
+        physics.push(cell);
+    }
+    pendingCells.clear();
+}
+
+SimulationCounts CPUSimulationBackend::getCounts()
+{
+    SimulationCounts counts;
+    counts.totalCells = static_cast<int>(cells.size());
+    counts.liveCells = counts.totalCells - static_cast<int>(freeCellSlots.size());
+    counts.totalAdhesions = static_cast<int>(connections.size());
+    counts.liveAdhesions = counts.totalAdhesions - static_cast<int>(freeAdhesionSlots.size());
+    return counts;
+}
+
+float CPUSimulationBackend::getMaxSpeed()
+{
+    float maxSpeed = 0.0f;
+    for (int i = 0; i < physics.size(); i++)
+    {
+        float speed = std::sqrt(physics.velX[i] * physics.velX[i] + physics.velY[i] * physics.velY[i] + physics.velZ[i] * physics.velZ[i]);
+        if (!std::isfinite(speed))
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+        maxSpeed = std::max(maxSpeed, speed);
+    }
+    return maxSpeed;
+}
+
+const std::vector<ComputeCell>& CPUSimulationBackend::getCells()
+{
+    const float divisionClock = getDivisionClock();
+    jobs.parallelFor(static_cast<int>(cells.size()), [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            physics.store(i, cells[i]);
+            cells[i].age = divisionClock - birthTimes[i];
+        }
+    });
+    return cells;
+}
+
+void CPUSimulationBackend::reset()
+{
+    cells.clear();
+    birthTimes.clear();
+    physics.clear();
+    pendingCells.clear();
+    connections.clear();
+    freeAdhesionSlots.clear();
+    freeCellSlots.clear();
+    timestepClock = 0.0;
+    divisionEpochOrigin = 0.0;
+    divisionScheduleDirty = true;
+    divisionTick = 0;
+    ticksSinceReorder = 0;
+    ticksSinceCompaction = 0;
+    previousTimeStep = 0.0f;
+    accelerationsCarried = false;
+}
+
+// ============================================================================
+// TICK
+// ============================================================================
+
+void CPUSimulationBackend::step(float deltaTime)
+{
+    applyPendingCells();
+
+    // Like CellManager::recordTick(), the clock and the priority seed move on even without cells
+    timestepClock += deltaTime;
+    const uint32_t tick = divisionTick++;
+
+    // Dead cells are compacted away every few ticks while there are any, and before every reorder
+    bool reorderDue = mortonReorderInterval > 0 && ++ticksSinceReorder >= mortonReorderInterval;
+    bool compactionDue = cellCompactionInterval > 0 && ++ticksSinceCompaction >= cellCompactionInterval &&
+        !freeCellSlots.empty();
+    if (reorderDue || compactionDue) ticksSinceCompaction = 0;
+    if (reorderDue) ticksSinceReorder = 0;
+
+    if (cells.empty())
+    {
+        updateDivisionEpoch();
+        return;
+    }
+
+    if (reorderDue || compactionDue)
+    {
+        compactCells();
+    }
+    if (reorderDue)
+    {
+        reorderCells();
+    }
+    updateSpatialGrid();
+    runPhysics();
+    runUpdate(deltaTime);
+    buildAdhesionAdjacency();
+    updateDivisionEpoch();
+    runInternalUpdate(tick);
+    previousTimeStep = deltaTime;
+}
+
+// Division clock (division_schedule.cpp)
+// Birth times are floats on the division clock, which restarts whenever the GPU would rebuild its division
+// wheel: after a reset or a genome change, and once the clock runs past the epoch (added and renumbered cells
+// don't end the epoch, see CellManager::remapDivisionWheel()). The same float
+// arithmetic as the shaders makes both backends find the same cells due on the same tick; summing ages tick
+// by tick rounds differently and can move a split by a tick, which changes the priority seed as well.
+void CPUSimulationBackend::updateDivisionEpoch()
+{
+    if (!divisionScheduleDirty && getDivisionSlot(getDivisionClock()) < divisionEpochSlots) return;
+
+    // CellManager::rebuildDivisionWheel() and division_wheel_count.comp
+    float originShift = getDivisionClock();
+    divisionEpochOrigin = timestepClock;
+    divisionSlotWidth = config::physicsTimeStep;
+    int intervalSlots = static_cast<int>(divisionMinSplitInterval / divisionSlotWidth) + 1;
+    divisionEpochSlots = std::clamp(intervalSlots, 2, config::DIVISION_WHEEL_SLOTS);
+    divisionScheduleDirty = false;
+
+    for (float& birthTime : birthTimes)
+    {
+        birthTime -= originShift;
+    }
+}
+
+int CPUSimulationBackend::getDivisionSlot(float divisionClock) const
+{
+    if (divisionClock <= 0.0f)
+        return 0;
+    float slot = std::ceil(divisionClock / divisionSlotWidth);
+    return static_cast<int>(std::min(slot, static_cast<float>(divisionEpochSlots)));
+}
+
+void CPUSimulationBackend::reorderCells()
+{
+    TimerCPU timer("Cell Reorder");
+    const int cellCount = physics.size();
+
+    // Same counting sort as the grid, keyed by Morton code; the serial slot claim keeps equal keys in
+    // index order, so the new order is deterministic
+    cellGridIndex.resize(cellCount);
+    jobs.parallelFor(cellCount, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            cellGridIndex[i] = gridToMortonIndex(worldToGrid(physics.position(i)));
+        }
+    });
+
+    // The reorder needs a true (key ordered) prefix sum, so it scans the whole grid; the keys still go on the
+    // occupied list, so the next grid update clears them
+    clearGridCounts();
+    for (int i = 0; i < cellCount; i++)
+    {
+        if (gridCounts[cellGridIndex[i]]++ == 0)
+        {
+            occupiedGridCells.push_back(cellGridIndex[i]);
+        }
+    }
+    uint32_t start = 0;
+    for (int g = 0; g < config::TOTAL_GRID_CELLS; g++)
+    {
+        gridStart[g] = start;
+        start += gridCounts[g];
+    }
+
+    reorderOrder.resize(cellCount);
+    reorderNewIndex.resize(cellCount);
+    for (int i = 0; i < cellCount; i++)
+    {
+        uint32_t newIndex = gridStart[cellGridIndex[i]]++;
+        reorderOrder[newIndex] = static_cast<uint32_t>(i);
+        reorderNewIndex[i] = newIndex;
+    }
+    gatherCells();
+}
+
+void CPUSimulationBackend::compactCells()
+{
+    if (freeCellSlots.empty()) return;
+    TimerCPU timer("Cell Compaction");
+    const int cellCount = physics.size();
+
+    // cell_compact_count/scan/gather.comp: a stable compaction of the cells that have mass
+    reorderOrder.clear();
+    reorderNewIndex.resize(cellCount);
+    for (int i = 0; i < cellCount; i++)
+    {
+        reorderNewIndex[i] = static_cast<uint32_t>(-1);
+        if (physics.mass[i] > 0.0f)
+        {
+            reorderNewIndex[i] = static_cast<uint32_t>(reorderOrder.size());
+            reorderOrder.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    gatherCells();
+
+    // Every cell is live now, so there are no free slots left
+    freeCellSlots.clear();
+}
+
+void CPUSimulationBackend::gatherCells()
+{
+    const int oldCount = physics.size();
+    const int newCount = static_cast<int>(reorderOrder.size());
+
+    // cell_reorder_gather.comp
+    physics.permute(reorderOrder);
+    reorderedCells.resize(newCount);
+    reorderedBirthTimes.resize(newCount);
+    jobs.parallelFor(newCount, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            reorderedCells[i] = cells[reorderOrder[i]];
+            reorderedBirthTimes[i] = birthTimes[reorderOrder[i]];
+        }
+    });
+    cells.swap(reorderedCells);
+    birthTimes.swap(reorderedBirthTimes);
+
+    // cell_reorder_remap_adhesions.comp; dead cells gave back their adhesions, so only inactive connections
+    // can end up pointing at -1
+    for (AdhesionConnection& connection : connections)
+    {
+        if (connection.cellAIndex < static_cast<uint32_t>(oldCount)) connection.cellAIndex = reorderNewIndex[connection.cellAIndex];
+        if (connection.cellBIndex < static_cast<uint32_t>(oldCount)) connection.cellBIndex = reorderNewIndex[connection.cellBIndex];
+    }
+}
+
+void CPUSimulationBackend::clearGridCounts()
+{
+    for (uint32_t g : occupiedGridCells)
+    {
+        gridCounts[g] = 0;
+    }
+    occupiedGridCells.clear();
+}
+
+void CPUSimulationBackend::updateSpatialGrid()
+{
+    TimerCPU timer("Spatial Grid Update");
+    const int cellCount = physics.size();
+
+    // grid_max_radius.comp
+    {
+        TimerCPU subTimer("Grid Max Radius");
+        float maxMass = physics.mass.empty() ? 0.0f : *std::max_element(physics.mass.begin(), physics.mass.end());
+        maxCellRadius = std::cbrt(maxMass);
+    }
+
+    // grid_clear.comp
+    {
+        TimerCPU subTimer("Grid Clear");
+        clearGridCounts();
+    }
+
+    // grid_assign.comp: the atomic count becomes a serial slot claim in cell index order,
+    // so the cells of a grid cell are always packed in the same order. Dead cells stay out of the grid
+    {
+        TimerCPU subTimer("Grid Assign");
+        const int levelCount = useMultiLevelGrid ? config::GRID_LEVEL_COUNT : 1;
+        cellGridIndex.resize(cellCount);
+        jobs.parallelFor(cellCount, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                if (physics.mass[i] <= 0.0f)
+                {
+                    cellGridIndex[i] = NOT_IN_GRID;
+                    continue;
+                }
+                int level = gridLevelForRadius(std::cbrt(physics.mass[i]), levelCount);
+                cellGridIndex[i] = levelGridToIndex(worldToLevelGrid(physics.position(i), level), level);
+            }
+        });
+
+        cellGridSlot.resize(cellCount);
+        for (int i = 0; i < cellCount; i++)
+        {
+            if (cellGridIndex[i] == NOT_IN_GRID) continue;
+            uint32_t slot = gridCounts[cellGridIndex[i]]++;
+            if (slot == 0)
+            {
+                occupiedGridCells.push_back(cellGridIndex[i]);
+            }
+            cellGridSlot[i] = slot;
+        }
+    }
+
+    // grid_occupied_scan.comp + grid_occupied_add.comp: only occupied grid cells get an offset
+    {
+        TimerCPU subTimer("Grid Prefix Sum");
+        uint32_t packedCount = 0;
+        for (uint32_t g : occupiedGridCells)
+        {
+            gridStart[g] = packedCount;
+            packedCount += gridCounts[g];
+        }
+    }
+
+    // grid_insert.comp, gathering positions and radii into grid order (every live cell gets an entry)
+    TimerCPU subTimer("Grid Insert");
+    sortedX.resize(cellCount);
+    sortedY.resize(cellCount);
+    sortedZ.resize(cellCount);
+    sortedRadius.resize(cellCount);
+    jobs.parallelFor(cellCount, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            if (cellGridIndex[i] == NOT_IN_GRID) continue;
+            uint32_t k = gridStart[cellGridIndex[i]] + cellGridSlot[i];
+            sortedX[k] = physics.posX[i];
+            sortedY[k] = physics.posY[i];
+            sortedZ[k] = physics.posZ[i];
+            sortedRadius[k] = std::cbrt(physics.mass[i]);
+        }
+    });
+}
+
+void CPUSimulationBackend::runPhysics()
+{
+    TimerCPU timer("Cell Physics Compute");
+    // Levels above the largest cell's are empty, as in cell_physics_spatial.comp
+    const int topLevel = gridLevelForRadius(maxCellRadius, useMultiLevelGrid ? config::GRID_LEVEL_COUNT : 1);
+
+    jobs.parallelFor(physics.size(), [&](int begin, int end)
+    {
+        for (int index = begin; index < end; index++)
+        {
+            float myMass = physics.mass[index];
+            if (myMass <= 0.0f)
+            {
+                // Dead cells stay where they are
+                physics.accX[index] = physics.accY[index] = physics.accZ[index] = 0.0f;
+                physics.stiffness[index] = 0.0f;
+                continue;
+            }
+            glm::vec3 myPos = physics.position(index);
+            float myRadius = std::cbrt(myMass);
+
+            glm::vec3 totalForce(0.0f);
+            float contactStiffness = 0.0f;
+            for (int level = 0; level <= topLevel; level++)
+            {
+                // Grid cells to search in every direction: enough to cover a contact with the largest cell
+                // this level can hold
+                const float levelCellSize = config::GRID_CELL_SIZE * static_cast<float>(1 << level);
+                const float levelMaxRadius = level == topLevel ? maxCellRadius : levelCellSize * 0.5f;
+                const int reach = std::max(1, static_cast<int>(std::ceil((myRadius + levelMaxRadius) / levelCellSize)));
+                const int levelResolution = config::GRID_RESOLUTION >> level;
+                glm::ivec3 myGridPos = worldToLevelGrid(myPos, level);
+
+                // Every occupied grid cell of the neighbourhood is one contiguous run; empty ones have no
+                // valid start
+                glm::ivec3 firstGridPos = glm::max(myGridPos - reach, glm::ivec3(0));
+                glm::ivec3 lastGridPos = glm::min(myGridPos + reach, glm::ivec3(levelResolution - 1));
+
+                for (int z = firstGridPos.z; z <= lastGridPos.z; z++)
+                {
+                    for (int y = firstGridPos.y; y <= lastGridPos.y; y++)
+                    {
+                        for (int x = firstGridPos.x; x <= lastGridPos.x; x++)
+                        {
+                            uint32_t grid = levelGridToIndex(glm::ivec3(x, y, z), level);
+                            uint32_t runLength = gridCounts[grid];
+                            if (runLength == 0) continue;
+
+                            uint32_t runStart = gridStart[grid];
+                            totalForce += accumulateCollisionForce(&sortedX[runStart], &sortedY[runStart], &sortedZ[runStart],
+                                &sortedRadius[runStart], static_cast<int>(runLength), myPos, myRadius, contactStiffness);
+                        }
+                    }
+                }
+            }
+
+            glm::vec3 acceleration = totalForce / myMass;
+            physics.accX[index] = acceleration.x;
+            physics.accY[index] = acceleration.y;
+            physics.accZ[index] = acceleration.z;
+            physics.stiffness[index] = contactStiffness / myMass;
+        }
+    });
+}
+
+// Bounce off a world wall with energy loss
+static inline void applyBounds(float& position, float& velocity)
+{
+    if (std::abs(position) > BOUNDS)
+    {
+        position = position > 0.0f ? BOUNDS : -BOUNDS;
+        velocity *= -0.8f;
+    }
+}
+
+void CPUSimulationBackend::runUpdate(float deltaTime)
+{
+    TimerCPU timer("Cell Update Compute");
+    const float damping = pow(DAMPING, deltaTime * 100.0f);
+    const float dampingRate = -100.0f * std::log(DAMPING);
+
+    // Velocity Verlet closes the last tick with the second half of its kick and damps over it, then drifts with
+    // the first half of this tick's (integrateVelocity and driftDistance in the shader)
+    const bool verlet = integrator == config::Integrator::VelocityVerlet;
+    const bool closeLastTick = verlet && accelerationsCarried;
+    const float closingKick = 0.5f * previousTimeStep;
+    const float closingDamping = pow(DAMPING, previousTimeStep * 100.0f);
+    const float openingKick = 0.5f * deltaTime;
+
+    jobs.parallelFor(physics.size(), [&](int begin, int end)
+    {
+        float* posX = physics.posX.data();
+        float* posY = physics.posY.data();
+        float* posZ = physics.posZ.data();
+        float* velX = physics.velX.data();
+        float* velY = physics.velY.data();
+        float* velZ = physics.velZ.data();
+        const float* accX = physics.accX.data();
+        const float* accY = physics.accY.data();
+        const float* accZ = physics.accZ.data();
+        const float* stiffness = physics.stiffness.data();
+        const float* mass = physics.mass.data();
+        float* carriedAccX = physics.carriedAccX.data();
+        float* carriedAccY = physics.carriedAccY.data();
+        float* carriedAccZ = physics.carriedAccZ.data();
+        float* carried = physics.carried.data();
+
+        for (int i = begin; i < end; i++)
+        {
+            if (mass[i] <= 0.0f) continue; // Dead
+
+            switch (integrator)
+            {
+            case config::Integrator::VelocityVerlet:
+                // New cells and child B have nothing carried and start over from their velocity
+                if (closeLastTick && carried[i] != 0.0f)
+                {
+                    velX[i] = (velX[i] + (carriedAccX[i] + accX[i]) * closingKick) * closingDamping;
+                    velY[i] = (velY[i] + (carriedAccY[i] + accY[i]) * closingKick) * closingDamping;
+                    velZ[i] = (velZ[i] + (carriedAccZ[i] + accZ[i]) * closingKick) * closingDamping;
+                }
+                carriedAccX[i] = accX[i];
+                carriedAccY[i] = accY[i];
+                carriedAccZ[i] = accZ[i];
+                carried[i] = 1.0f;
+                break;
+            case config::Integrator::SemiImplicit:
+            {
+                float implicitScale = 1.0f / (1.0f + deltaTime * (dampingRate + stiffness[i] * deltaTime));
+                velX[i] = (velX[i] + accX[i] * deltaTime) * implicitScale;
+                velY[i] = (velY[i] + accY[i] * deltaTime) * implicitScale;
+                velZ[i] = (velZ[i] + accZ[i] * deltaTime) * implicitScale;
+                break;
+            }
+            default:
+                velX[i] = (velX[i] + accX[i] * deltaTime) * damping;
+                velY[i] = (velY[i] + accY[i] * deltaTime) * damping;
+                velZ[i] = (velZ[i] + accZ[i] * deltaTime) * damping;
+                break;
+            }
+            if (verlet)
+            {
+                posX[i] += (velX[i] + accX[i] * openingKick) * deltaTime;
+                posY[i] += (velY[i] + accY[i] * openingKick) * deltaTime;
+                posZ[i] += (velZ[i] + accZ[i] * openingKick) * deltaTime;
+            }
+            else
+            {
+                posX[i] += velX[i] * deltaTime;
+                posY[i] += velY[i] * deltaTime;
+                posZ[i] += velZ[i] * deltaTime;
+            }
+            applyBounds(posX[i], velX[i]);
+            applyBounds(posY[i], velY[i]);
+            applyBounds(posZ[i], velZ[i]);
+        }
+    });
+    accelerationsCarried = verlet;
+}
+
+void CPUSimulationBackend::buildAdhesionAdjacency()
+{
+    TimerCPU timer("Adhesion Adjacency");
+    const int cellCount = static_cast<int>(cells.size());
+    const int connectionCount = static_cast<int>(connections.size());
+
+    // adhesion_adjacency_count.comp
+    adhesionCounts.assign(cellCount, 0u);
+    for (const AdhesionConnection& connection : connections)
+    {
+        if (connection.isActive == 0) continue;
+        adhesionCounts[connection.cellAIndex]++;
+        adhesionCounts[connection.cellBIndex]++;
+    }
+
+    // adhesion_adjacency_offsets.comp
+    adhesionOffsets.resize(cellCount + 1);
+    adhesionOffsets[0] = 0;
+    for (int i = 0; i < cellCount; i++)
+    {
+        adhesionOffsets[i + 1] = adhesionOffsets[i] + adhesionCounts[i];
+        adhesionCounts[i] = 0;
+    }
+
+    // adhesion_adjacency_fill.comp
+    adhesionNeighbors.resize(adhesionOffsets[cellCount]);
+    for (int connectionIndex = 0; connectionIndex < connectionCount; connectionIndex++)
+    {
+        const AdhesionConnection& connection = connections[connectionIndex];
+        if (connection.isActive == 0) continue;
+        uint32_t cellA = connection.cellAIndex;
+        uint32_t cellB = connection.cellBIndex;
+        adhesionNeighbors[adhesionOffsets[cellA] + adhesionCounts[cellA]++] = AdhesionNeighbor{ cellB, static_cast<uint32_t>(connectionIndex) };
+        adhesionNeighbors[adhesionOffsets[cellB] + adhesionCounts[cellB]++] = AdhesionNeighbor{ cellA, static_cast<uint32_t>(connectionIndex) };
+    }
+}
+
+void CPUSimulationBackend::runInternalUpdate(uint32_t tick)
+{
+    TimerCPU timer("Cell Internal Update Compute");
+    const int cellCount = static_cast<int>(cells.size());
+    const int modeCount = static_cast<int>(modes.size());
+    const float divisionClock = getDivisionClock();
+
+    // Decide every split and death against the pre-split state, like division_decide.comp: a cell is due once
+    // its split (or death) time has passed by the end of this tick, and the priority between adhered cells
+    // that are due together is seeded with the tick
+    divisionDecisions.assign(cellCount, DIVISION_NONE);
+    jobs.parallelFor(cellCount, [&](int begin, int end)
+    {
+        for (int index = begin; index < end; index++)
+        {
+            const ComputeCell& cell = cells[index];
+            if (cell.modeIndex < 0 || cell.modeIndex >= modeCount) continue;
+            if (birthTimes[index] + getSplitInterval(modes[cell.modeIndex]) > divisionClock) continue;
+
+            // Adhered cells that are splitting in the same tick take turns by priority
+            float myPriority = hash11(static_cast<uint32_t>(index) ^ tick);
+            bool deferred = false;
+            for (uint32_t i = adhesionOffsets[index]; i < adhesionOffsets[index + 1] && !deferred; ++i)
+            {
+                uint32_t otherIdx = adhesionNeighbors[i].cellIndex;
+                const ComputeCell& other = cells[otherIdx];
+                if (other.modeIndex < 0 || other.modeIndex >= modeCount) continue;
+                if (birthTimes[otherIdx] + getSplitInterval(modes[other.modeIndex]) > divisionClock) continue;
+
+                // Ties go to the higher index, as in division_decide.comp
+                float otherPriority = hash11(otherIdx ^ tick);
+                deferred = otherPriority > myPriority || (otherPriority == myPriority && otherIdx > static_cast<uint32_t>(index));
+            }
+            if (!deferred)
+            {
+                divisionDecisions[index] = diesBeforeSplit(modes[cell.modeIndex]) ? DIVISION_DEATH : DIVISION_SPLIT;
+            }
+        }
+    });
+
+    // Apply the splits and deaths in index order. Children B take free cell slots from the top of the stack,
+    // then ones past the end; splits past the room for new cells stay due for the next tick, highest index
+    // first, as division_rank_scan.comp drops them. Slots given back (adhesions and dead cells) only become
+    // free after every split, like the pushes division_commit.comp settles, so the slots each split takes
+    // are the ones the GPU hands out by rank
+    int childRoom = cellLimit - (cellCount - static_cast<int>(freeCellSlots.size()));
+    releasedAdhesions.clear();
+    releasedCells.clear();
+    for (int index = 0; index < cellCount; index++)
+    {
+        if (divisionDecisions[index] == DIVISION_NONE) continue;
+        if (divisionDecisions[index] == DIVISION_DEATH)
+        {
+            killCell(index);
+            continue;
+        }
+        if (childRoom == 0) continue;
+        childRoom--;
+
+        int newIndex = static_cast<int>(cells.size());
+        if (!freeCellSlots.empty())
+        {
+            newIndex = freeCellSlots.back();
+            freeCellSlots.pop_back();
+        }
+
+        const ComputeCell cell = cells[index];
+        const GPUMode& mode = modes[cell.modeIndex];
+        uint32_t childAIndex = static_cast<uint32_t>(index);
+        uint32_t childBIndex = static_cast<uint32_t>(newIndex);
+
+        glm::vec3 parentPosition = physics.position(index);
+        glm::vec3 offset = rotateVectorByQuaternion(glm::vec3(mode.splitDirection), cell.orientation) * 0.5f;
+        float splitTime = birthTimes[index] + mode.splitInterval;
+
+        const float tinyAngle = 0.001f * 0.017453292519943295f;
+        glm::quat qChildA = glm::normalize(glm::normalize(cell.orientation * mode.orientationA) * smallRandomQuat(tinyAngle, childAIndex));
+        glm::quat qChildB = glm::normalize(glm::normalize(cell.orientation * mode.orientationB) * smallRandomQuat(tinyAngle, childBIndex));
+
+        ComputeCell childA = cell;
+        childA.modeIndex = mode.childModes.x;
+        childA.orientation = qChildA;
+
+        ComputeCell childB = cell;
+        childB.modeIndex = mode.childModes.y;
+        childB.orientation = qChildB;
+
+        // Inherit adhesions in connection index order (the adjacency is filled in that order): the first
+        // child that keeps a connection takes it over in place, child B gets a copy when both keep it, and
+        // it is given back when neither does (the new connections only show up in the next tick's adjacency)
+        const bool keepA = mode.childAKeepAdhesion == 1;
+        const bool keepB = mode.childBKeepAdhesion == 1;
+        for (uint32_t i = adhesionOffsets[index]; i < adhesionOffsets[index + 1]; ++i)
+        {
+            int oldAdhesionIndex = static_cast<int>(adhesionNeighbors[i].connectionIndex);
+            uint32_t neighborIndex = adhesionNeighbors[i].cellIndex;
+
+            AdhesionConnection oldConnection = connections[oldAdhesionIndex];
+            if (oldConnection.isActive == 0) continue;
+
+            if (keepA || keepB)
+            {
+                connections[oldAdhesionIndex] = AdhesionConnection{ keepA ? childAIndex : childBIndex, neighborIndex, oldConnection.modeIndex, 1 };
+            }
+            else
+            {
+                connections[oldAdhesionIndex].isActive = 0;
+                releaseAdhesion(oldAdhesionIndex);
+            }
+
+            if (keepA && keepB)
+            {
+                int newIdx = allocateAdhesion();
+                if (newIdx >= 0)
+                {
+                    connections[newIdx] = AdhesionConnection{ childBIndex, neighborIndex, oldConnection.modeIndex, 1 };
+                }
+            }
+        }
+
+        // Adhesion between the two children
+        if (mode.parentMakeAdhesion != 0)
+        {
+            int adhesionIndex = allocateAdhesion();
+            if (adhesionIndex >= 0)
+            {
+                connections[adhesionIndex] = AdhesionConnection{ childAIndex, childBIndex, static_cast<uint32_t>(cell.modeIndex), 1 };
+            }
+        }
+
+        cells[index] = childA;
+        birthTimes[index] = splitTime;
+        if (newIndex == static_cast<int>(cells.size()))
+        {
+            cells.push_back(childB);
+            birthTimes.push_back(splitTime);
+            physics.pushCopy(index);
+        }
+        else
+        {
+            cells[newIndex] = childB;
+            birthTimes[newIndex] = splitTime;
+            physics.copy(index, newIndex);
+        }
+        physics.carried[newIndex] = 0.0f; // Child B starts velocity Verlet over, child A goes on from its parent
+        physics.setPosition(index, parentPosition + offset);
+        physics.setPosition(newIndex, parentPosition - offset);
+    }
+    freeAdhesionSlots.insert(freeAdhesionSlots.end(), releasedAdhesions.begin(), releasedAdhesions.end());
+    freeCellSlots.insert(freeCellSlots.end(), releasedCells.begin(), releasedCells.end());
+}
+
+void CPUSimulationBackend::killCell(int index)
+{
+    // The cell gives back its adhesions (in connection index order) and its slot, and stays behind as a hole:
+    // massless, at rest and never due, until a child takes its slot or it is compacted away
+    for (uint32_t i = adhesionOffsets[index]; i < adhesionOffsets[index + 1]; ++i)
+    {
+        int adhesionIndex = static_cast<int>(adhesionNeighbors[i].connectionIndex);
+        connections[adhesionIndex].isActive = 0;
+        releaseAdhesion(adhesionIndex);
+    }
+
+    physics.mass[index] = 0.0f;
+    physics.velX[index] = physics.velY[index] = physics.velZ[index] = 0.0f;
+    birthTimes[index] = std::numeric_limits<float>::infinity();
+    releasedCells.push_back(index);
+}
+
+// ============================================================================
+// ADHESION SLOTS
+// ============================================================================
+
+int CPUSimulationBackend::allocateAdhesion()
+{
+    // Reuse freed slots first, like the free stack in getNewAdhesionIndex()
+    if (!freeAdhesionSlots.empty())
+    {
+        int adhesionIndex = freeAdhesionSlots.back();
+        freeAdhesionSlots.pop_back();
+        return adhesionIndex;
+    }
+    if (static_cast<int>(connections.size()) >= adhesionLimit)
+    {
+        return -1;
+    }
+    connections.push_back(AdhesionConnection{});
+    return static_cast<int>(connections.size()) - 1;
+}
+
+void CPUSimulationBackend::releaseAdhesion(int adhesionIndex)
+{
+    // Pushed onto the free stack once the tick's splits are done (runInternalUpdate)
+    releasedAdhesions.push_back(adhesionIndex);
+}
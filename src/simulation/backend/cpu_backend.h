@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "simulation_backend.h"
+#include "cell_soa.h"
+#include "../../utils/job_system.h"
+
+// Multithreaded CPU port of the simulation compute shaders, for machines without a GPU
+// Every pass mirrors its shader (see the comment above each pass); per-cell work is spread over a
+// JobSystem, and anything the shaders resolve with atomics (grid slots, new cell/adhesion indices)
+// is resolved serially in cell index order, which makes CPU runs reproducible.
+// Physics state lives in a CellSoA; the ComputeCell records hold everything else and only get their
+// physics fields refreshed by getCells().
+class CPUSimulationBackend : public SimulationBackend
+{
+public:
+    explicit CPUSimulationBackend(int cellLimit = config::MAX_CELLS, int threadCount = 0);
+
+    const char* getName() const override { return "cpu"; }
+
+    void setGenome(const GenomeData& genome) override;
+    void addCell(const ComputeCell& cell) override;
+    void spawnCells(int count) override;
+    void setSpawnRadius(float radius) override { spawnRadius = radius; }
+    void applyPendingCells() override;
+    void step(float deltaTime) override;
+    void setIntegrator(config::Integrator newIntegrator) override { integrator = newIntegrator; }
+    SimulationCounts getCounts() override;
+    float getMaxSpeed() override;
+    int getMaxCells() const override { return cellLimit; }
+    void reset() override;
+
+    int getThreadCount() const { return jobs.getThreadCount(); }
+    const std::vector<ComputeCell>& getCells();
+    const std::vector<AdhesionConnection>& getAdhesionConnections() const { return connections; }
+
+    float spawnRadius = config::DEFAULT_SPAWN_RADIUS;
+    int mortonReorderInterval = config::defaultMortonReorderInterval; // Ticks between Morton reorders, 0 = off
+    int cellCompactionInterval = config::defaultCellCompactionInterval; // Ticks between compacting dead cells out, 0 = only before a reorder
+    bool useMultiLevelGrid = config::defaultUseMultiLevelGrid;       // Power of two grid levels, as in CellManager
+    config::Integrator integrator = config::defaultIntegrator;
+
+private:
+    // Tick passes, in the order CellManager::updateCells() runs them
+    void compactCells();                      // cell_death.cpp: drops the dead cells, keeping the live ones in order
+    void reorderCells();                      // cell_reorder.cpp: Morton order counting sort, remaps adhesions
+    void updateSpatialGrid();                 // grid_clear, grid_assign, grid_insert, plus the grid-sorted gather
+    void runPhysics();                        // cell_physics_spatial.comp: positions -> accelerations
+    void runUpdate(float deltaTime);          // cell_update.comp: integrates the physics streams in place
+    void buildAdhesionAdjacency();            // adhesion_adjacency_*.comp: per-cell lists of active connections
+    void updateDivisionEpoch();               // rebuildDivisionWheel(): restarts the division clock when due
+    void runInternalUpdate(uint32_t tick);    // division_decide.comp, cell_update_internal.comp: division and adhesion handover
+
+    void clearGridCounts();                   // Zeroes the counts of the occupied grid cells only
+    float getDivisionClock() const { return static_cast<float>(timestepClock - divisionEpochOrigin); }
+    int getDivisionSlot(float divisionClock) const; // As CellManager::getDivisionSlot()
+
+    void gatherCells();                       // Moves cell reorderOrder[i] to i and remaps the adhesions
+    void killCell(int index);                 // cell_death.cpp: frees the cell's adhesions and slot
+    int allocateAdhesion();
+    void releaseAdhesion(int adhesionIndex);
+
+    JobSystem jobs;
+    int cellLimit;
+    int adhesionLimit;
+
+    std::vector<GPUMode> modes;
+    CellSoA physics;                      // Positions, masses, velocities, accelerations
+    std::vector<ComputeCell> cells;       // Everything else (orientation, mode, adhesions...); ages are set by getCells()
+    std::vector<float> birthTimes;        // On the division clock, like CellCold::birthTime
+    std::vector<ComputeCell> pendingCells;
+
+    std::vector<AdhesionConnection> connections;
+    std::vector<int> freeAdhesionSlots;
+    std::vector<int> releasedAdhesions;   // Given back by this tick's splits, free from the next tick on
+    std::vector<int> freeCellSlots;       // Slots of dead cells, the top at the back
+    std::vector<int> releasedCells;       // Died this tick, free from the next tick on
+
+    // Adhesion adjacency (CSR): a true prefix sum over the counts, filled in connection index order,
+    // where the GPU hands out the runs with an atomic allocator
+    std::vector<uint32_t> adhesionCounts;
+    std::vector<uint32_t> adhesionOffsets;    // cellCount + 1 entries
+    std::vector<AdhesionNeighbor> adhesionNeighbors;
+
+    // Spatial grid: the same counting sort as the GPU grid, except that the positions and radii of the sorted
+    // cells are gathered into parallel streams as well. A neighbour grid cell is then one contiguous run for
+    // the SIMD kernel.
+    // Like the GPU grid, only occupied grid cells are cleared and scanned, so the packed order is the order
+    // in which grid cells were first touched and gridStart is only valid where gridCounts is non-zero.
+    std::vector<uint32_t> gridCounts;     // Cells that fell into each grid cell (zero outside occupiedGridCells)
+    std::vector<uint32_t> gridStart;      // First packed entry of each grid cell
+    std::vector<uint32_t> occupiedGridCells; // Grid cells with a non-zero count, in first touch order
+    float maxCellRadius = 0.0f;           // grid_max_radius.comp: sets how many grid cells physics reaches out
+    std::vector<uint32_t> cellGridIndex;  // Grid cell of every cell, from the assign pass
+    std::vector<uint32_t> cellGridSlot;   // Slot claimed in that grid cell by the insert pass
+    std::vector<float> sortedX, sortedY, sortedZ, sortedRadius;
+
+    enum DivisionDecision : uint8_t { DIVISION_NONE, DIVISION_SPLIT, DIVISION_DEATH };
+    std::vector<uint8_t> divisionDecisions; // Made in parallel before any split or death is applied
+    uint32_t divisionTick = 0;            // Ticks since the reset, seeds the priority between adhered splits
+
+    // Division clock, as in CellManager (see updateDivisionEpoch())
+    double timestepClock = 0.0;           // Simulation time since the reset
+    double divisionEpochOrigin = 0.0;     // timestepClock at the start of the epoch: 0 on the division clock
+    float divisionSlotWidth = config::physicsTimeStep;
+    int divisionEpochSlots = 2;
+    float divisionMinSplitInterval = 0.0f;
+    bool divisionScheduleDirty = true;
+
+    // Cell reorder
+    int ticksSinceReorder = 0;
+    int ticksSinceCompaction = 0;
+    float previousTimeStep = 0.0f;            // Length of the last tick (velocity Verlet), 0 before the first
+    bool accelerationsCarried = false;        // Whether the last tick was a velocity Verlet update
+    std::vector<uint32_t> reorderOrder;       // Old index of every new index
+    std::vector<uint32_t> reorderNewIndex;    // New index of every old index
+    std::vector<ComputeCell> reorderedCells;
+    std::vector<float> reorderedBirthTimes;
+};
@@ -0,0 +1,69 @@
+#include "gpu_backend.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+GPUSimulationBackend::GPUSimulationBackend(int cellLimit)
+{
+    cellManager.setCellLimit(std::min(cellLimit, config::MAX_CELLS));
+}
+
+void GPUSimulationBackend::setGenome(const GenomeData& genome)
+{
+    cellManager.addGenomeToBuffer(genome);
+}
+
+void GPUSimulationBackend::addCell(const ComputeCell& cell)
+{
+    cellManager.addCellToStagingBuffer(cell);
+}
+
+void GPUSimulationBackend::spawnCells(int count)
+{
+    cellManager.spawnCells(count);
+}
+
+void GPUSimulationBackend::applyPendingCells()
+{
+    cellManager.addStagedCellsToQueueBuffer();
+}
+
+void GPUSimulationBackend::step(float deltaTime)
+{
+    cellManager.updateCells(deltaTime);
+}
+
+void GPUSimulationBackend::finish()
+{
+    cellManager.flushBarriers();
+    glFinish();
+}
+
+float GPUSimulationBackend::getMaxSpeed()
+{
+    // The last tick's speed reduction (see TimestepStats), read straight from the buffer
+    cellManager.addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    cellManager.flushBarriers();
+
+    TimestepStats stats;
+    glGetNamedBufferSubData(cellManager.timestepStatsBuffer, 0, sizeof(stats), &stats);
+    return std::isfinite(stats.maxSpeed) ? stats.maxSpeed : std::numeric_limits<float>::infinity();
+}
+
+SimulationCounts GPUSimulationBackend::getCounts()
+{
+    // Exact counts for the report, so wait for the copy instead of taking the latest finished one
+    cellManager.waitForCounts();
+
+    SimulationCounts counts;
+    counts.totalCells = cellManager.totalCellCount;
+    counts.liveCells = cellManager.liveCellCount;
+    counts.totalAdhesions = cellManager.totalAdhesionCount;
+    counts.liveAdhesions = cellManager.liveAdhesionCount;
+    return counts;
+}
+
+void GPUSimulationBackend::reset()
+{
+    cellManager.resetSimulation();
+}
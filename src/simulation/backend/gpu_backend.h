@@ -0,0 +1,31 @@
+#pragma once
+#include "simulation_backend.h"
+#include "../cell/cell_manager.h"
+
+// Compute shader simulation, a thin wrapper around CellManager
+// Requires a current OpenGL 4.6 context for its whole lifetime.
+class GPUSimulationBackend : public SimulationBackend
+{
+public:
+    explicit GPUSimulationBackend(int cellLimit = config::MAX_CELLS);
+
+    const char* getName() const override { return "gpu"; }
+
+    void setGenome(const GenomeData& genome) override;
+    void addCell(const ComputeCell& cell) override;
+    void spawnCells(int count) override;
+    void setSpawnRadius(float radius) override { cellManager.spawnRadius = radius; }
+    void applyPendingCells() override;
+    void step(float deltaTime) override;
+    void setIntegrator(config::Integrator integrator) override { cellManager.integrator = integrator; }
+    void finish() override;
+    SimulationCounts getCounts() override;
+    float getMaxSpeed() override;
+    int getMaxCells() const override { return config::MAX_CELLS; } // CellManager sizes its buffers for MAX_CELLS
+    void reset() override;
+
+    CellManager& getCellManager() { return cellManager; }
+
+private:
+    CellManager cellManager;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "../cell/common_structs.h"
+
+// Same four counters as the GPU cell count buffer
+struct SimulationCounts
+{
+    int totalCells = 0;
+    int liveCells = 0;
+    int totalAdhesions = 0;
+    int liveAdhesions = 0;
+};
+
+// A cell simulation that can be stepped without any rendering attached.
+// Implementations run the same tick passes (grid, physics, update, internal update) and report
+// them to TimerManager under the same names, so timings from different backends can be compared.
+class SimulationBackend
+{
+public:
+    virtual ~SimulationBackend() = default;
+
+    virtual const char* getName() const = 0;
+
+    virtual void setGenome(const GenomeData& genome) = 0;
+
+    // Queue a cell; queued cells enter the simulation on the next applyPendingCells() or step()
+    virtual void addCell(const ComputeCell& cell) = 0;
+    virtual void spawnCells(int count) = 0;           // Random cells within the spawn radius
+    virtual void setSpawnRadius(float radius) = 0;
+    virtual void applyPendingCells() = 0;
+
+    virtual void step(float deltaTime) = 0;
+    virtual void setIntegrator(config::Integrator integrator) = 0;
+
+    // Block until every submitted tick has completed (GPU work is asynchronous)
+    virtual void finish() {}
+
+    virtual SimulationCounts getCounts() = 0;
+    virtual float getMaxSpeed() = 0;                  // Fastest cell after the last step (+inf if any speed isn't finite)
+
+    // Most cells this backend can hold; the GPU backend is capped by the buffers CellManager allocates
+    virtual int getMaxCells() const = 0;
+    virtual void reset() = 0;
+};
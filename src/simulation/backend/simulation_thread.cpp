@@ -0,0 +1,151 @@
+#include "simulation_thread.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+SimulationThread::SimulationThread(int cellLimit, int workerThreads)
+    : backend(cellLimit, workerThreads)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start()
+{
+    if (running.exchange(true))
+        return;
+    thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+    running.store(false);
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+void SimulationThread::reset(const GenomeData& genome, const ComputeCell& firstCell)
+{
+    std::lock_guard<std::mutex> lock(commandMutex);
+    commands.push_back([this, genome, firstCell]()
+    {
+        backend.reset();
+        backend.setGenome(genome);
+        backend.addCell(firstCell);
+        backend.applyPendingCells();
+        tick = 0;
+        simulationTime = 0.0f;
+    });
+}
+
+void SimulationThread::applyCommands()
+{
+    std::vector<std::function<void()>> pending;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        pending.swap(commands);
+    }
+
+    for (auto& command : pending)
+    {
+        command();
+    }
+    if (!pending.empty())
+    {
+        snapshotStale = true;
+    }
+}
+
+void SimulationThread::publishSnapshot()
+{
+    SimulationSnapshot& snapshot = snapshots.getWriteBuffer();
+    snapshot.cells = backend.getCells(); // Reuses the snapshot's storage once it is large enough
+    snapshot.connections = backend.getAdhesionConnections();
+    snapshot.counts = backend.getCounts();
+    snapshot.tick = tick;
+    snapshot.simulationTime = simulationTime;
+    snapshots.publish();
+    snapshotStale = false;
+}
+
+void SimulationThread::run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point lastTime = Clock::now();
+    Clock::time_point lastPublish = lastTime;
+    Clock::time_point rateWindowStart = lastTime;
+    uint64_t rateWindowTicks = 0;
+    float accumulator = 0.0f;
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        applyCommands();
+
+        Clock::time_point now = Clock::now();
+        float elapsed = std::chrono::duration<float>(now - lastTime).count();
+        lastTime = now;
+
+        // Tick count for this pass: real time times the speed (at most maxAccumulatorTime of it, like the render
+        // loop), or one tick at a time as fast as they run
+        float timeStep = config::physicsTimeStep;
+        int ticks = 0;
+        if (!paused.load(std::memory_order_relaxed))
+        {
+            if (unlimited.load(std::memory_order_relaxed))
+            {
+                ticks = 1;
+                accumulator = 0.0f;
+            }
+            else
+            {
+                accumulator += elapsed * simulationSpeed.load(std::memory_order_relaxed);
+                accumulator = std::min(accumulator, config::maxAccumulatorTime);
+                ticks = static_cast<int>(accumulator / timeStep);
+                accumulator -= ticks * timeStep;
+            }
+        }
+        else
+        {
+            accumulator = 0.0f;
+        }
+
+        for (int i = 0; i < ticks; i++)
+        {
+            backend.step(timeStep);
+            tick++;
+            simulationTime += timeStep;
+        }
+        if (ticks > 0)
+        {
+            snapshotStale = true;
+            rateWindowTicks += ticks;
+        }
+
+        now = Clock::now();
+        if (snapshotStale && now - lastPublish >= std::chrono::duration<float>(config::SIMULATION_SNAPSHOT_INTERVAL))
+        {
+            publishSnapshot();
+            lastPublish = now;
+        }
+
+        float rateWindow = std::chrono::duration<float>(now - rateWindowStart).count();
+        if (rateWindow >= 1.0f)
+        {
+            ticksPerSecond.store(rateWindowTicks / rateWindow, std::memory_order_relaxed);
+            rateWindowStart = now;
+            rateWindowTicks = 0;
+        }
+
+        // Nothing to do until the next tick is due (or the next snapshot, for a change that hasn't been shown)
+        if (ticks == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cpu_backend.h"
+#include "../../utils/triple_buffer.h"
+
+// What the render thread needs to draw and inspect the simulation at one point in time
+struct SimulationSnapshot
+{
+    std::vector<ComputeCell> cells;
+    std::vector<AdhesionConnection> connections;
+    SimulationCounts counts;
+    uint64_t tick = 0;
+    float simulationTime = 0.0f;
+};
+
+// Runs a CPUSimulationBackend on its own thread, so a slow frame, UI interaction or a genome resimulation in
+// the preview scene never holds up the simulation, and a burst of ticks never holds up the frame.
+// The render thread hands over work as commands (applied before the next tick) and picks up the newest state
+// as a snapshot through a lock-free triple buffer. Snapshots are published after every batch of ticks, at most
+// once per config::SIMULATION_SNAPSHOT_INTERVAL.
+// Ticks follow real time times the speed, like the render loop's accumulator, or run back to back when unlimited.
+class SimulationThread
+{
+public:
+    explicit SimulationThread(int cellLimit = config::MAX_CELLS, int workerThreads = 0);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Commands (render thread)
+    void reset(const GenomeData& genome, const ComputeCell& firstCell); // New simulation from one cell
+    void setPaused(bool pause) { paused.store(pause, std::memory_order_relaxed); }
+    void setSpeed(float speed) { simulationSpeed.store(speed, std::memory_order_relaxed); }
+    void setUnlimited(bool unlimitedRate) { unlimited.store(unlimitedRate, std::memory_order_relaxed); }
+    bool isUnlimited() const { return unlimited.load(std::memory_order_relaxed); }
+
+    // Snapshots (render thread): acquireSnapshot() is true when a newer snapshot than the last one is available
+    bool acquireSnapshot() { return snapshots.acquire(); }
+    const SimulationSnapshot& getSnapshot() const { return snapshots.getReadBuffer(); }
+
+    float getTicksPerSecond() const { return ticksPerSecond.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void applyCommands();
+    void publishSnapshot();
+
+    CPUSimulationBackend backend; // Only touched by the simulation thread while it runs
+    std::thread thread;
+    std::atomic<bool> running{ false };
+
+    std::mutex commandMutex;      // Guards commands only; held just long enough to queue or take them
+    std::vector<std::function<void()>> commands;
+    bool snapshotStale = true;    // Simulation thread: state changed since the last published snapshot
+
+    std::atomic<bool> paused{ false };
+    std::atomic<bool> unlimited{ false };
+    std::atomic<float> simulationSpeed{ 1.0f };
+    std::atomic<float> ticksPerSecond{ 0.0f };
+
+    uint64_t tick = 0;            // Simulation thread only
+    float simulationTime = 0.0f;
+
+    TripleBuffer<SimulationSnapshot> snapshots;
+};
@@ -58,7 +58,7 @@ void CellManager::updateAdhesionLineData()
     adhesionLineExtractShader->use();
 
     // Bind cell data as input
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     // Bind adhesionSettings connection buffer as input
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, adhesionConnectionBuffer);
     // Bind adhesionSettings line buffer as output
@@ -67,8 +67,7 @@ void CellManager::updateAdhesionLineData()
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer);
 
     // Dispatch compute shader
-    GLuint numGroups = (totalAdhesionCount + 63) / 64;
-    adhesionLineExtractShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(adhesionLineExtractShader, DISPATCH_ADHESIONS_64);
 
     // Use targeted barrier for buffer copy
     addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
@@ -148,6 +147,58 @@ void CellManager::initializeAdhesionConnectionSystem()
         nullptr, GL_DYNAMIC_READ);  // GPU produces data, CPU reads for connection count
     
     std::cout << "Initialized adhesionSettings connection system with capacity for " << cellLimit * config::MAX_ADHESIONS_PER_CELL << " connections\n";
+
+    // Adhesion adjacency: every active connection is listed under both of its cells
+    glCreateBuffers(1, &adhesionCountBuffer);
+    glNamedBufferData(adhesionCountBuffer, cellLimit * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+
+    glCreateBuffers(1, &adhesionOffsetBuffer);
+    glNamedBufferData(adhesionOffsetBuffer, (cellLimit + 1) * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+
+    glCreateBuffers(1, &adhesionNeighborBuffer);
+    glNamedBufferData(adhesionNeighborBuffer,
+        cellLimit * config::MAX_ADHESIONS_PER_CELL * sizeof(AdhesionNeighbor), // Two entries per connection
+        nullptr, GL_DYNAMIC_COPY);
+}
+
+void CellManager::buildAdhesionAdjacency()
+{
+    TimerGPU timer("Adhesion Adjacency");
+
+    // Reset the per-cell counts and the allocation cursor in front of the offsets
+    glClearNamedBufferData(adhesionCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glClearNamedBufferSubData(adhesionOffsetBuffer, GL_R32UI, 0, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Count the active connections of every cell
+    adhesionAdjacencyCountShader->use();
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, adhesionConnectionBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, adhesionCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+    dispatchIndirect(adhesionAdjacencyCountShader, DISPATCH_ADHESIONS_256);
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Reserve a run of neighbour entries per cell
+    adhesionAdjacencyOffsetsShader->use();
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, adhesionCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, adhesionOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+    dispatchIndirect(adhesionAdjacencyOffsetsShader, DISPATCH_CELLS_256);
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Fill the runs (this also restores the counts)
+    adhesionAdjacencyFillShader->use();
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, adhesionConnectionBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, adhesionCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, adhesionOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, adhesionNeighborBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gpuCellCountBuffer);
+    dispatchIndirect(adhesionAdjacencyFillShader, DISPATCH_ADHESIONS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
 void CellManager::runAdhesionPhysics()
@@ -162,20 +213,21 @@ void CellManager::runAdhesionPhysics()
     adhesionPhysicsShader->setInt("u_gridResolution", config::GRID_RESOLUTION);
     adhesionPhysicsShader->setFloat("u_gridCellSize", config::GRID_CELL_SIZE);
     adhesionPhysicsShader->setFloat("u_worldSize", config::WORLD_SIZE);
-    adhesionPhysicsShader->setInt("u_maxCellsPerGrid", config::MAX_CELLS_PER_GRID);
     adhesionPhysicsShader->setInt("u_maxConnections", cellLimit * config::MAX_ADHESIONS_PER_CELL);
     
     // Bind buffers
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellWriteBuffer()); // Cell data
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer); // Cell positions and velocities
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, modeBuffer); // Mode data
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridBuffer); // Spatial grid
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gridCountBuffer); // Grid counts
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, adhesionConnectionBuffer); // Output connections
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, gpuCellCountBuffer); // Cell count
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, adhesionCountBuffer); // Adhesion adjacency
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, adhesionOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, adhesionNeighborBuffer);
     
-    // Dispatch compute shader
-    GLuint numGroups = (totalAdhesionCount + 255) / 256;
-    adhesionPhysicsShader->dispatch(numGroups, 1, 1);
+    // Dispatch compute shader (one invocation per cell, which walks its adjacency)
+    dispatchIndirect(adhesionPhysicsShader, DISPATCH_CELLS_256);
     
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
@@ -187,6 +239,15 @@ void CellManager::cleanupAdhesionConnectionSystem()
         glDeleteBuffers(1, &adhesionConnectionBuffer);
         adhesionConnectionBuffer = 0;
     }
+    GLuint* adjacencyBuffers[] = { &adhesionCountBuffer, &adhesionOffsetBuffer, &adhesionNeighborBuffer };
+    for (GLuint* buffer : adjacencyBuffers)
+    {
+        if (*buffer != 0)
+        {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
     totalAdhesionCount = 0;
 }
 
@@ -241,17 +302,37 @@ std::vector<AdhesionConnection> CellManager::getAdhesionConnections() const
     return connections;
 }
 
+int CellManager::rebuildFreeAdhesionSlots(const AdhesionConnection* connections, int count)
+{
+    // The stack starts at entry 1 (see division_commit.comp); slots past its capacity just stay unused
+    const int capacity = cellLimit * config::MAX_ADHESIONS_PER_CELL / 2;
+    std::vector<GLuint> freeSlots;
+    for (int i = 0; i < count && static_cast<int>(freeSlots.size()) < capacity; ++i)
+    {
+        if (connections[i].isActive == 0)
+            freeSlots.push_back(static_cast<GLuint>(i));
+    }
+    if (!freeSlots.empty())
+    {
+        glNamedBufferSubData(freeAdhesionSlotBuffer, sizeof(GLuint), freeSlots.size() * sizeof(GLuint), freeSlots.data());
+    }
+    return count - static_cast<int>(freeSlots.size());
+}
+
 void CellManager::restoreAdhesionConnections(const std::vector<AdhesionConnection> &connections, int count)
 {
     if (count == 0) {
         totalAdhesionCount = 0;
+        liveAdhesionCount = 0;
         // Clear the adhesion connection buffer
         glClearNamedBufferData(adhesionConnectionBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
         return;
     }
     
-    // Update adhesion count
+    // Update adhesion count; inactive connections go back on the free adhesion stack
+    count = std::min(count, static_cast<int>(connections.size()));
     totalAdhesionCount = count;
+    liveAdhesionCount = rebuildFreeAdhesionSlots(connections.data(), count);
     
     // Update the adhesion connection buffer
     glNamedBufferSubData(adhesionConnectionBuffer,
@@ -259,7 +340,8 @@ void CellManager::restoreAdhesionConnections(const std::vector<AdhesionConnectio
                          count * sizeof(AdhesionConnection),
                          connections.data());
     
-    // Update the GPU cell count buffer
+    // Update the GPU cell count buffer; the restored cells are all live (restoreCellsDirectlyToGPUBuffer)
+    liveCellCount = totalCellCount;
     GLuint counts[4] = { static_cast<GLuint>(totalCellCount), static_cast<GLuint>(liveCellCount), static_cast<GLuint>(totalAdhesionCount), static_cast<GLuint>(liveAdhesionCount) };
     glNamedBufferSubData(gpuCellCountBuffer, 0, sizeof(GLuint) * 4, counts);
     
@@ -0,0 +1,146 @@
+#include "cell_manager.h"
+#include "../../core/config.h"
+#include <utility>
+#include "../../utils/timer.h"
+
+// Cell death and dead cell compaction
+// A mode with a lifespan shorter than its split interval dies at that age instead of splitting. Death goes
+// through the division schedule like a split: the wheel lists the cell at its birth time plus the lifespan,
+// division_decide.comp marks it with a death bit, division_rank_scan.comp ranks the deaths, and the split
+// pass (cell_update_internal.comp) gives back the cell's adhesions and pushes its index on the free cell
+// slot stack, which division_commit.comp settles along with the adhesion stack.
+//
+// A dead cell stays behind as a hole: massless, at rest, born at +inf so that it never comes due. Every pass
+// that walks the cells skips massless ones (the sleep pass puts them to sleep for good), and new children
+// take the holes from the free cell slot stack before growing the cell count.
+//
+// Holes that aren't refilled still cost every full-range dispatch, so compactCells() moves the live cells to
+// a dense prefix every cellCompactionInterval ticks while there are any, and right before every Morton
+// reorder, whose permutation only holds the cells in the grid. CPU-side bulk writes (keyframe restores,
+// snapshots) count every cell they write as live, so the free cell slot stack stays empty, and ask for a
+// compaction on the next tick to drop any dead cells among them. Compaction is a stream compaction in three
+// passes: live cells per 256 cells, an exclusive scan over those blocks, and a stable gather. Afterwards
+// both cell counts are the live count, so the free cell slot stack is empty. Indices are remapped the way
+// cell_reorder.cpp does it, with the same remap buffer and adhesion pass; a selected cell that died is
+// deselected.
+void CellManager::compactCells()
+{
+    cellCompactionPending = false;
+    if (totalCellCount == 0)
+        return;
+    TimerGPU timer("Cell Compaction");
+
+    // Like the reorder, every dispatch is sized by the GPU cell count, which may be ahead of totalCellCount
+    {
+        TimerGPU countTimer("Cell Compaction Count");
+
+        cellCompactCountShader->use();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpuCellCountBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, cellCompactionBuffer);
+
+        dispatchIndirect(cellCompactCountShader, DISPATCH_CELLS_256);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    {
+        TimerGPU scanTimer("Cell Compaction Scan");
+
+        cellCompactScanShader->use();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpuCellCountBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellCompactionBuffer);
+
+        cellCompactScanShader->dispatch(1, 1, 1);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Move the live cells down (hot and the carried accelerations to the back buffers, cold to the write buffer)
+    {
+        TimerGPU gatherTimer("Cell Compaction Gather");
+
+        cellCompactGatherShader->use();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellHotBackBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, getCellColdReadBuffer());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, getCellColdWriteBuffer());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, cellRemapBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, gpuCellCountBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, cellCompactionBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, cellCarriedAccelerationBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, cellCarriedAccelerationBackBuffer);
+
+        dispatchIndirect(cellCompactGatherShader, DISPATCH_CELLS_256);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        std::swap(cellHotBuffer, cellHotBackBuffer);
+        std::swap(cellCarriedAccelerationBuffer, cellCarriedAccelerationBackBuffer);
+        swapColdBuffers();
+    }
+
+    // The fused pass skips sleeping cells, so both hot buffers must hold them (see cell_sleep.cpp)
+    if (useSleeping)
+    {
+        addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        flushBarriers();
+        glCopyNamedBufferSubData(cellHotBuffer, cellHotBackBuffer, 0, 0, cellLimit * sizeof(CellHot));
+    }
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Point the adhesion connections at the new indices; this needs the old cell count, so it runs before the
+    // counts shrink. Dead cells gave back their adhesions when they died, so only inactive connections can
+    // end up pointing at -1
+    {
+        TimerGPU remapTimer("Cell Compaction Remap");
+
+        cellReorderRemapShader->use();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, adhesionConnectionBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellRemapBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+
+        dispatchIndirect(cellReorderRemapShader, DISPATCH_ADHESIONS_256);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        // The division wheel and retry list as well, sized by the old cell count
+        remapDivisionWheel();
+    }
+
+    // Both cell counts become the live count, which empties the free cell slot stack
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    glCopyNamedBufferSubData(cellCompactionBuffer, gpuCellCountBuffer, 0, 0, sizeof(GLuint));
+    glCopyNamedBufferSubData(cellCompactionBuffer, gpuCellCountBuffer, 0, sizeof(GLuint), sizeof(GLuint));
+
+    // The selected (or dragged) cell has moved as well, or died; this is the only readback, and only while a
+    // cell is selected
+    if (selectedCell.isValid && selectedCell.cellIndex >= 0 && selectedCell.cellIndex < cellLimit)
+    {
+        GLuint newIndex = 0;
+        glGetNamedBufferSubData(cellRemapBuffer, selectedCell.cellIndex * sizeof(GLuint), sizeof(GLuint), &newIndex);
+        if (newIndex == static_cast<GLuint>(-1))
+            clearSelection();
+        else
+            selectedCell.cellIndex = static_cast<int>(newIndex);
+    }
+
+    // Neighbour lists hold the old indices
+    invalidateNeighborLists();
+
+    // The passes after this are sized by the new count
+    runDispatchArgs();
+}
@@ -2,10 +2,12 @@
 #include "../../rendering/camera/camera.h"
 #include "../../core/config.h"
 #include "../../ui/ui_manager.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
+#include <limits>
 #include <vector>
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -16,6 +18,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include "../../utils/timer.h"
+#include "../backend/simulation_thread.h"
+#include "genome_io.h"
+#include "../../utils/job_system.h"
 
 // ============================================================================
 // CONSTRUCTOR & DESTRUCTOR
@@ -29,19 +34,56 @@ CellManager::CellManager()
 
     initializeGPUBuffers();
     initializeSpatialGrid();
+    initializeDivisionSchedule();
 
     // Initialize compute shaders
     physicsShader = new Shader("shaders/cell/physics/cell_physics_spatial.comp"); // Use spatial partitioning version
     updateShader = new Shader("shaders/cell/physics/cell_update.comp");
+    fusedPhysicsShader = new Shader("shaders/cell/physics/cell_physics_fused.comp");
     internalUpdateShader = new Shader("shaders/cell/physics/cell_update_internal.comp");
     extractShader = new Shader("shaders/cell/management/extract_instances.comp");
     cellAdditionShader = new Shader("shaders/cell/management/apply_additions.comp");
+    cellAdditionCountShader = new Shader("shaders/cell/management/apply_additions_count.comp");
 
     // Initialize spatial grid shaders
+    gridMaxRadiusShader = new Shader("shaders/spatial/grid_max_radius.comp");
     gridClearShader = new Shader("shaders/spatial/grid_clear.comp");
     gridAssignShader = new Shader("shaders/spatial/grid_assign.comp");
     gridPrefixSumShader = new Shader("shaders/spatial/grid_prefix_sum.comp");
+    gridPrefixAddShader = new Shader("shaders/spatial/grid_prefix_add.comp");
+    gridOccupiedScanShader = new Shader("shaders/spatial/grid_occupied_scan.comp");
+    gridOccupiedAddShader = new Shader("shaders/spatial/grid_occupied_add.comp");
     gridInsertShader = new Shader("shaders/spatial/grid_insert.comp");
+    gridRankShader = new Shader("shaders/spatial/grid_rank.comp");
+
+    // Initialize neighbour list shaders
+    neighborListBuildShader = new Shader("shaders/spatial/neighbor_list_build.comp");
+    neighborListCheckShader = new Shader("shaders/spatial/neighbor_list_check.comp");
+
+    // Initialize cell reorder shaders
+    cellReorderGatherShader = new Shader("shaders/cell/management/cell_reorder_gather.comp");
+    cellReorderRemapShader = new Shader("shaders/cell/management/cell_reorder_remap_adhesions.comp");
+
+    // Initialize dead cell compaction shaders
+    cellCompactCountShader = new Shader("shaders/cell/management/cell_compact_count.comp");
+    cellCompactScanShader = new Shader("shaders/cell/management/cell_compact_scan.comp");
+    cellCompactGatherShader = new Shader("shaders/cell/management/cell_compact_gather.comp");
+
+    // Initialize indirect dispatch shader
+    dispatchArgsShader = new Shader("shaders/cell/management/dispatch_args.comp");
+
+    // Initialize sleeping cell shader
+    cellSleepShader = new Shader("shaders/cell/management/cell_sleep.comp");
+
+    // Initialize division timing wheel shaders
+    divisionWheelCountShader = new Shader("shaders/cell/management/division_wheel_count.comp");
+    divisionWheelScanShader = new Shader("shaders/cell/management/division_wheel_scan.comp");
+    divisionWheelScatterShader = new Shader("shaders/cell/management/division_wheel_scatter.comp");
+    divisionWheelRemapShader = new Shader("shaders/cell/management/division_wheel_remap.comp");
+    divisionScheduleShader = new Shader("shaders/cell/management/division_schedule.comp");
+    divisionDecideShader = new Shader("shaders/cell/management/division_decide.comp");
+    divisionRankScanShader = new Shader("shaders/cell/management/division_rank_scan.comp");
+    divisionCommitShader = new Shader("shaders/cell/management/division_commit.comp");
     
     // Initialize gizmo shaders
     gizmoExtractShader = new Shader("shaders/rendering/debug/gizmo_extract.comp");
@@ -57,6 +99,11 @@ CellManager::CellManager()
     
     // Initialize adhesionSettings physics  shader
     adhesionPhysicsShader = new Shader("shaders/cell/physics/adhesion_physics.comp");
+
+    // Initialize adhesion adjacency shaders
+    adhesionAdjacencyCountShader = new Shader("shaders/cell/management/adhesion_adjacency_count.comp");
+    adhesionAdjacencyOffsetsShader = new Shader("shaders/cell/management/adhesion_adjacency_offsets.comp");
+    adhesionAdjacencyFillShader = new Shader("shaders/cell/management/adhesion_adjacency_fill.comp");
     
     // Initialize gizmo buffers
     initializeGizmoBuffers();
@@ -72,6 +119,19 @@ CellManager::CellManager()
     
     // Initialize barrier optimization system
     barrierBatch.setStats(&barrierStats);
+
+    // An optional pass whose program failed to link would silently do nothing, so its toggle is kept off
+    sleepingAvailable = cellSleepShader->isLinked();
+    disableUnavailableFeatures();
+}
+
+void CellManager::disableUnavailableFeatures()
+{
+    if (useSleeping && !sleepingAvailable)
+    {
+        std::cout << "Sleeping cells disabled: cell_sleep.comp failed to link\n";
+        useSleeping = false;
+    }
 }
 
 CellManager::~CellManager()
@@ -85,13 +145,46 @@ CellManager::~CellManager()
 
 void CellManager::cleanup()
 {
-    // Clean up triple buffered cell buffers
-    for (int i = 0; i < 3; i++)
+    // Clean up cell buffers
+    if (cellHotBuffer != 0)
+    {
+        glDeleteBuffers(1, &cellHotBuffer);
+        cellHotBuffer = 0;
+    }
+    if (cellHotBackBuffer != 0)
+    {
+        glDeleteBuffers(1, &cellHotBackBuffer);
+        cellHotBackBuffer = 0;
+    }
+    if (cellRemapBuffer != 0)
+    {
+        glDeleteBuffers(1, &cellRemapBuffer);
+        cellRemapBuffer = 0;
+    }
+    if (cellCompactionBuffer != 0)
+    {
+        glDeleteBuffers(1, &cellCompactionBuffer);
+        cellCompactionBuffer = 0;
+    }
+    if (cellAccelerationBuffer != 0)
+    {
+        glDeleteBuffers(1, &cellAccelerationBuffer);
+        cellAccelerationBuffer = 0;
+    }
+    for (GLuint* buffer : { &cellCarriedAccelerationBuffer, &cellCarriedAccelerationBackBuffer })
+    {
+        if (*buffer != 0)
+        {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    for (int i = 0; i < 2; i++)
     {
-        if (cellBuffer[i] != 0)
+        if (cellColdBuffer[i] != 0)
         {
-            glDeleteBuffers(1, &cellBuffer[i]);
-            cellBuffer[i] = 0;
+            glDeleteBuffers(1, &cellColdBuffer[i]);
+            cellColdBuffer[i] = 0;
         }
     }
     if (instanceBuffer != 0)
@@ -109,10 +202,23 @@ void CellManager::cleanup()
         glDeleteBuffers(1, &gpuCellCountBuffer);
         gpuCellCountBuffer = 0;
     }
-    if (stagingCellCountBuffer != 0)
+    countReadback.cleanup();
+    if (timestepStatsBuffer != 0)
+    {
+        glDeleteBuffers(1, &timestepStatsBuffer);
+        timestepStatsBuffer = 0;
+    }
+    timestepStatsReadback.cleanup();
+    if (activeCellBuffer != 0)
+    {
+        glDeleteBuffers(1, &activeCellBuffer);
+        activeCellBuffer = 0;
+    }
+    activeCountReadback.cleanup();
+    if (dispatchArgsBuffer != 0)
     {
-        glDeleteBuffers(1, &stagingCellCountBuffer);
-        stagingCellCountBuffer = 0;
+        glDeleteBuffers(1, &dispatchArgsBuffer);
+        dispatchArgsBuffer = 0;
     }
     if (stagingCellBuffer != 0)
     {
@@ -136,6 +242,8 @@ void CellManager::cleanup()
     }
 
     cleanupSpatialGrid();
+    cleanupNeighborLists();
+    cleanupDivisionSchedule();
     cleanupLODSystem();
     cleanupUnifiedCulling();
 
@@ -145,6 +253,12 @@ void CellManager::cleanup()
         delete extractShader;
         extractShader = nullptr;
     }
+    if (cellAdditionCountShader)
+    {
+        cellAdditionCountShader->destroy();
+        delete cellAdditionCountShader;
+        cellAdditionCountShader = nullptr;
+    }
     if (physicsShader)
     {
         physicsShader->destroy();
@@ -157,8 +271,20 @@ void CellManager::cleanup()
         delete updateShader;
         updateShader = nullptr;
     }
+    if (fusedPhysicsShader)
+    {
+        fusedPhysicsShader->destroy();
+        delete fusedPhysicsShader;
+        fusedPhysicsShader = nullptr;
+    }
 
     // Cleanup spatial grid shaders
+    if (gridMaxRadiusShader)
+    {
+        gridMaxRadiusShader->destroy();
+        delete gridMaxRadiusShader;
+        gridMaxRadiusShader = nullptr;
+    }
     if (gridClearShader)
     {
         gridClearShader->destroy();
@@ -177,12 +303,105 @@ void CellManager::cleanup()
         delete gridPrefixSumShader;
         gridPrefixSumShader = nullptr;
     }
+    if (gridPrefixAddShader)
+    {
+        gridPrefixAddShader->destroy();
+        delete gridPrefixAddShader;
+        gridPrefixAddShader = nullptr;
+    }
+    if (gridOccupiedScanShader)
+    {
+        gridOccupiedScanShader->destroy();
+        delete gridOccupiedScanShader;
+        gridOccupiedScanShader = nullptr;
+    }
+    if (gridOccupiedAddShader)
+    {
+        gridOccupiedAddShader->destroy();
+        delete gridOccupiedAddShader;
+        gridOccupiedAddShader = nullptr;
+    }
     if (gridInsertShader)
     {
         gridInsertShader->destroy();
         delete gridInsertShader;
         gridInsertShader = nullptr;
     }
+    if (gridRankShader)
+    {
+        gridRankShader->destroy();
+        delete gridRankShader;
+        gridRankShader = nullptr;
+    }
+
+    // Cleanup neighbour list shaders
+    if (neighborListBuildShader)
+    {
+        neighborListBuildShader->destroy();
+        delete neighborListBuildShader;
+        neighborListBuildShader = nullptr;
+    }
+    if (neighborListCheckShader)
+    {
+        neighborListCheckShader->destroy();
+        delete neighborListCheckShader;
+        neighborListCheckShader = nullptr;
+    }
+
+    // Cleanup cell reorder shaders
+    if (cellReorderGatherShader)
+    {
+        cellReorderGatherShader->destroy();
+        delete cellReorderGatherShader;
+        cellReorderGatherShader = nullptr;
+    }
+    if (cellReorderRemapShader)
+    {
+        cellReorderRemapShader->destroy();
+        delete cellReorderRemapShader;
+        cellReorderRemapShader = nullptr;
+    }
+    if (cellCompactCountShader)
+    {
+        cellCompactCountShader->destroy();
+        delete cellCompactCountShader;
+        cellCompactCountShader = nullptr;
+    }
+    if (cellCompactScanShader)
+    {
+        cellCompactScanShader->destroy();
+        delete cellCompactScanShader;
+        cellCompactScanShader = nullptr;
+    }
+    if (cellCompactGatherShader)
+    {
+        cellCompactGatherShader->destroy();
+        delete cellCompactGatherShader;
+        cellCompactGatherShader = nullptr;
+    }
+    if (dispatchArgsShader)
+    {
+        dispatchArgsShader->destroy();
+        delete dispatchArgsShader;
+        dispatchArgsShader = nullptr;
+    }
+    if (cellSleepShader)
+    {
+        cellSleepShader->destroy();
+        delete cellSleepShader;
+        cellSleepShader = nullptr;
+    }
+    Shader** divisionShaders[] = { &divisionWheelCountShader, &divisionWheelScanShader, &divisionWheelScatterShader, &divisionWheelRemapShader,
+        &divisionScheduleShader, &divisionDecideShader, &divisionRankScanShader, &divisionCommitShader };
+    for (Shader** shader : divisionShaders)
+    {
+        if (*shader)
+        {
+            (*shader)->destroy();
+            delete *shader;
+            *shader = nullptr;
+        }
+    }
     
     // Cleanup gizmo shaders
     if (gizmoExtractShader)
@@ -223,10 +442,22 @@ void CellManager::cleanup()
         delete adhesionPhysicsShader;
         adhesionPhysicsShader = nullptr;
     }
+
+    Shader** adjacencyShaders[] = { &adhesionAdjacencyCountShader, &adhesionAdjacencyOffsetsShader, &adhesionAdjacencyFillShader };
+    for (Shader** shader : adjacencyShaders)
+    {
+        if (*shader)
+        {
+            (*shader)->destroy();
+            delete *shader;
+            *shader = nullptr;
+        }
+    }
     
     cleanupGizmos();
     cleanupRingGizmos();
     cleanupAdhesionLines();
+    cleanupAdhesionConnectionSystem();
     cleanupLODSystem();
     sphereMesh.cleanup();
 }
@@ -236,16 +467,65 @@ void CellManager::cleanup()
 // ============================================================================
 
 void CellManager::initializeGPUBuffers()
-{    // Create triple buffered compute buffers for cell data
-    for (int i = 0; i < 3; i++)
+{   // Create the compute buffers for cell data, split into hot, acceleration and cold parts
+    std::vector<CellHot> defaultHot(cellLimit);
+    glCreateBuffers(1, &cellHotBuffer);
+    glNamedBufferData(
+        cellHotBuffer,
+        cellLimit * sizeof(CellHot),
+        defaultHot.data(),
+        GL_DYNAMIC_COPY  // Used by both GPU compute and CPU read operations
+    );
+
+    glCreateBuffers(1, &cellHotBackBuffer);
+    glNamedBufferData(
+        cellHotBackBuffer,
+        cellLimit * sizeof(CellHot),
+        defaultHot.data(),
+        GL_DYNAMIC_COPY
+    );
+
+    glCreateBuffers(1, &cellRemapBuffer);
+    glNamedBufferData(
+        cellRemapBuffer,
+        cellLimit * sizeof(GLuint),
+        nullptr,
+        GL_DYNAMIC_COPY
+    );
+
+    glCreateBuffers(1, &cellCompactionBuffer);
+    glNamedBufferData(
+        cellCompactionBuffer,
+        (1 + (cellLimit + 255) / 256) * sizeof(GLuint), // Live count, then one entry per 256 cells
+        nullptr,
+        GL_DYNAMIC_COPY
+    );
+
+    std::vector<glm::vec4> zeroAccelerations(cellLimit, glm::vec4(0.0f));
+    glCreateBuffers(1, &cellAccelerationBuffer);
+    glNamedBufferData(
+        cellAccelerationBuffer,
+        cellLimit * sizeof(glm::vec4),
+        zeroAccelerations.data(),
+        GL_DYNAMIC_COPY
+    );
+
+    // Zero stamps: nothing carried yet
+    for (GLuint* buffer : { &cellCarriedAccelerationBuffer, &cellCarriedAccelerationBackBuffer })
     {
-        std::vector<ComputeCell> zeroCells(cellLimit);
-        glCreateBuffers(1, &cellBuffer[i]);
+        glCreateBuffers(1, buffer);
+        glNamedBufferData(*buffer, cellLimit * sizeof(glm::vec4), zeroAccelerations.data(), GL_DYNAMIC_COPY);
+    }
+
+    std::vector<CellCold> defaultCold(cellLimit);
+    for (int i = 0; i < 2; i++)
+    {
+        glCreateBuffers(1, &cellColdBuffer[i]);
         glNamedBufferData(
-            cellBuffer[i],
-            cellLimit * sizeof(ComputeCell),
-            zeroCells.data(),
-            GL_DYNAMIC_COPY  // Used by both GPU compute and CPU read operations
+            cellColdBuffer[i],
+            cellLimit * sizeof(CellCold),
+            defaultCold.data(),
+            GL_DYNAMIC_COPY
         );
     }
 
@@ -262,14 +542,14 @@ void CellManager::initializeGPUBuffers()
     glCreateBuffers(1, &freeCellSlotBuffer);
     glNamedBufferData(
         freeCellSlotBuffer,
-        cellLimit * sizeof(int),
+        (cellLimit + 1) * sizeof(int), // The stack starts at entry 1
         nullptr,
         GL_DYNAMIC_COPY  // GPU produces data, GPU consumes for rendering
     );
     glCreateBuffers(1, &freeAdhesionSlotBuffer);
     glNamedBufferData(
         freeAdhesionSlotBuffer,
-        cellLimit * config::MAX_ADHESIONS_PER_CELL * sizeof(int) / 2,
+        (cellLimit * config::MAX_ADHESIONS_PER_CELL / 2 + 1) * sizeof(int), // The stack starts at entry 1
         nullptr,
         GL_DYNAMIC_COPY  // GPU produces data, GPU consumes for rendering
     );
@@ -290,18 +570,31 @@ void CellManager::initializeGPUBuffers()
         nullptr,
         GL_DYNAMIC_STORAGE_BIT
     );
-    glCreateBuffers(1, &stagingCellCountBuffer);
+    countReadback.init(sizeof(GLuint) * config::COUNTER_NUMBER);
+
+    // Reductions of every tick for the adaptive time step, reset by the CPU at the start of the tick
+    glCreateBuffers(1, &timestepStatsBuffer);
+    glNamedBufferStorage(timestepStatsBuffer, sizeof(TimestepStats), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    timestepStatsReadback.init(sizeof(TimestepStats));
+
+    // Work group counts for indirect dispatch, written by dispatch_args.comp (nothing to do until then)
+    glCreateBuffers(1, &dispatchArgsBuffer);
     glNamedBufferStorage(
-        stagingCellCountBuffer,
-        sizeof(GLuint) * config::COUNTER_NUMBER,
+        dispatchArgsBuffer,
+        sizeof(GLuint) * 3 * DISPATCH_ARGS_SLOT_COUNT,
         nullptr,
-        GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_DYNAMIC_STORAGE_BIT
+        GL_DYNAMIC_STORAGE_BIT
     );
-    mappedPtr = glMapNamedBufferRange(stagingCellCountBuffer, 0, sizeof(GLuint) * config::COUNTER_NUMBER,
-        GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
-    countPtr = static_cast<GLuint*>(mappedPtr);
+    glClearNamedBufferData(dispatchArgsBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    // Awake cell list for sleeping cells, written by cell_sleep.comp (dispatch_args.comp always reads its count)
+    glCreateBuffers(1, &activeCellBuffer);
+    glNamedBufferStorage(activeCellBuffer, (cellLimit + 1) * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glClearNamedBufferData(activeCellBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    activeCountReadback.init(sizeof(GLuint));
 
     // Cell data staging buffer for CPU reads (avoids GPU->CPU transfer warnings)
+    // Readback packs the hot, acceleration and cold parts back to back, which adds up to one ComputeCell per cell
     glCreateBuffers(1, &stagingCellBuffer);
     glNamedBufferStorage(
         stagingCellBuffer,
@@ -377,8 +670,10 @@ void CellManager::addStagedCellsToQueueBuffer()
 
     applyCellAdditions(); // Add the cells from gpu queue buffer to main cell buffers
 
-    // CRITICAL FIX: Update CPU-side cell count to match GPU after adding cells
-    updateCounts();
+    // Count the new cells straight away (the readback confirms it a tick or two later) so that the cell
+    // limit checks and the statistics don't wait for it
+    totalCellCount = std::min(totalCellCount + pendingCellCount, cellLimit);
+    liveCellCount = std::min(liveCellCount + pendingCellCount, cellLimit);
 
     pendingCellCount = 0;      // Reset pending count
 }
@@ -401,27 +696,67 @@ void CellManager::restoreCellsDirectlyToGPUBuffer(const std::vector<ComputeCell>
     
     TimerGPU gpuTimer("Restoring Cells Directly to GPU Buffers");
     
-    // Update main cell buffers directly (both current and previous for consistency)
-    for (int i = 0; i < 3; i++) { // Update all 3 buffers for proper rotation
-        glNamedBufferSubData(cellBuffer[i],
-                             0, // Start from beginning
-                             newCellCount * sizeof(ComputeCell),
-                             cells.data());
-    }
+    // Update main cell buffers directly (both cold buffers for consistency)
+    writeCellsToGPU(0, cells.data(), newCellCount);
     
-    // Update cell count directly
+    // Update cell count directly; every restored cell counts as live, so the free cell slot stack is empty
+    // (dead cells among them are compacted away next tick, see cell_death.cpp)
     totalCellCount = newCellCount;
-    GLuint counts[config::COUNTER_NUMBER] = { static_cast<GLuint>(totalCellCount), static_cast<GLuint>(totalAdhesionCount), static_cast<GLuint>(pendingCellCount) }; // totalCellCount, totalAdhesionCount, pendingCellCount
-    glNamedBufferSubData(gpuCellCountBuffer, 0, sizeof(GLuint) * config::COUNTER_NUMBER, counts);
+    liveCellCount = newCellCount;
+    cellCompactionPending = true;
+    GLuint counts[config::COUNTER_NUMBER] = { static_cast<GLuint>(totalCellCount), static_cast<GLuint>(liveCellCount),
+        static_cast<GLuint>(totalAdhesionCount), static_cast<GLuint>(liveAdhesionCount) };
+    glNamedBufferSubData(gpuCellCountBuffer, 0, sizeof(counts), counts);
     
-    // Sync staging buffer
-    syncCounterBuffers();
+    // Count and timestep stats copies still in flight predate the restore
+    discardCountReadbacks();
+    discardTimestepStats();
     
     // Clear addition buffer since we're not using it
     glClearNamedBufferData(cellAdditionBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
     
     // Ensure GPU buffers are synchronized before proceeding
     glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Size the passes for the restored cells (rendering may come before the next tick)
+    runDispatchArgs();
+}
+
+void CellManager::presentSnapshot(const SimulationSnapshot& snapshot)
+{
+    TimerCPU timer("Present Snapshot");
+
+    int cellCount = std::min(static_cast<int>(snapshot.cells.size()), cellLimit);
+    int connectionCount = std::min(static_cast<int>(snapshot.connections.size()), config::MAX_ADHESIONS);
+
+    writeCellsToGPU(0, snapshot.cells.data(), cellCount);
+    if (connectionCount > 0)
+    {
+        glNamedBufferSubData(adhesionConnectionBuffer, 0, connectionCount * sizeof(AdhesionConnection), snapshot.connections.data());
+    }
+
+    // The free slot stacks aren't part of the snapshot: every cell counts as live (dead ones are compacted
+    // away if ticks run here again) and the free adhesion stack is rebuilt from the inactive connections.
+    // Copies in flight are of the state it replaces
+    totalCellCount = cellCount;
+    liveCellCount = cellCount;
+    cellCompactionPending = true;
+    totalAdhesionCount = connectionCount;
+    liveAdhesionCount = rebuildFreeAdhesionSlots(snapshot.connections.data(), connectionCount);
+    GLuint counts[config::COUNTER_NUMBER] = { static_cast<GLuint>(totalCellCount), static_cast<GLuint>(liveCellCount),
+        static_cast<GLuint>(totalAdhesionCount), static_cast<GLuint>(liveAdhesionCount) };
+    glNamedBufferSubData(gpuCellCountBuffer, 0, sizeof(counts), counts);
+    discardCountReadbacks();
+
+    // For getCellData() and the cell inspector
+    cpuCells.assign(snapshot.cells.begin(), snapshot.cells.begin() + cellCount);
+
+    invalidateNeighborLists();
+    invalidateStatisticsCache();
+
+    // Size extraction and culling for the new cells
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    runDispatchArgs();
 }
 
 void CellManager::setCPUCellData(const std::vector<ComputeCell> &cells)
@@ -435,68 +770,34 @@ void CellManager::setCPUCellData(const std::vector<ComputeCell> &cells)
     }
     
     totalCellCount = static_cast<int>(cells.size());
+    liveCellCount = totalCellCount; // Matches restoreCellsDirectlyToGPUBuffer(), the free cell slot stack is empty
     pendingCellCount = 0;
 }
 
-// ============================================================================
-// UTILITY FUNCTIONS
-// ============================================================================
-
-glm::vec3 pitchYawToVec3(float pitch, float yaw) {
-    return glm::vec3(
-        cos(pitch) * sin(yaw),
-        sin(pitch),
-        cos(pitch) * cos(yaw)
-    );
-}
-
 // ============================================================================
 // GENOME & MODE MANAGEMENT
 // ============================================================================
 
-void CellManager::addGenomeToBuffer(GenomeData& genomeData) const {
+void CellManager::addGenomeToBuffer(const GenomeData& genomeData) {
     int genomeBaseOffset = 0; // Later make it add to the end of the buffer
-    int modeCount = static_cast<int>(genomeData.modes.size());
-
-    std::vector<GPUMode> gpuModes;
-    gpuModes.reserve(modeCount);
-
-    for (size_t i = 0; i < modeCount; ++i) {
-        const ModeSettings& mode = genomeData.modes[i];
-
-        GPUMode gmode{};
-        gmode.color = glm::vec4(mode.color, 0.0);
-        gmode.splitInterval = mode.splitInterval;
-        gmode.genomeOffset = genomeBaseOffset;
-
-        // Convert from pitch and yaw to padded vec4
-        gmode.splitDirection = glm::vec4(pitchYawToVec3(
-            glm::radians(mode.parentSplitDirection.x), glm::radians(mode.parentSplitDirection.y)), 0.);
-
-        // Store child mode indices
-        gmode.childModes = glm::ivec2(mode.childA.modeNumber, mode.childB.modeNumber);
-
-        // Directly store quaternions (no conversion)
-        gmode.orientationA = mode.childA.orientation;  // now a quat already
-        gmode.orientationB = mode.childB.orientation;
-        
-        // Store adhesionSettings flag
-        gmode.parentMakeAdhesion = mode.parentMakeAdhesion;
-        gmode.childAKeepAdhesion = 1;//mode.childA.keepAdhesion;
-        gmode.childBKeepAdhesion = 1;//mode.childB.keepAdhesion;
-
-        // Store adhesionSettings settings
-        gmode.adhesionSettings = mode.adhesionSettings;
-
-        gpuModes.push_back(gmode);
-    }
+    std::vector<GPUMode> gpuModes = buildGPUModes(genomeData, genomeBaseOffset);
 
     glNamedBufferSubData(
         modeBuffer,
         genomeBaseOffset,
-        modeCount * sizeof(GPUMode),
+        gpuModes.size() * sizeof(GPUMode),
         gpuModes.data()
     );
+
+    // The split intervals and lifespans may have changed, and with them every cell's split or death time
+    divisionMinSplitInterval = 0.0f;
+    for (const GPUMode& mode : gpuModes)
+    {
+        float interval = (mode.lifespan > 0.0f && mode.lifespan < mode.splitInterval) ? mode.lifespan : mode.splitInterval;
+        if (divisionMinSplitInterval == 0.0f || interval < divisionMinSplitInterval)
+            divisionMinSplitInterval = interval;
+    }
+    invalidateDivisionSchedule();
 }
 
 // ============================================================================
@@ -525,15 +826,42 @@ void CellManager::updateCellData(int index, const ComputeCell &newData)
             selectedCell.cellData = newData;
         }
 
-        // Update the specific cell in both GPU buffers to keep them synchronized
-        for (int i = 0; i < 2; i++)
+        // Update the specific cell in the GPU buffers to keep them synchronized
+        writeCellsToGPU(index, &cpuCells[index], 1);
+    }
+}
+
+void CellManager::writeCellsToGPU(int firstIndex, const ComputeCell* cells, int count)
+{
+    if (count <= 0) return;
+
+    std::vector<CellHot> hot(count);
+    std::vector<glm::vec4> accelerations(count);
+    std::vector<CellCold> cold(count);
+    const float divisionClock = getDivisionClock();
+    JobSystem::get().parallelFor(count, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
         {
-            glNamedBufferSubData(cellBuffer[i],
-                                 index * sizeof(ComputeCell),
-                                 sizeof(ComputeCell),
-                                 &cpuCells[index]);
+            hot[i] = getCellHot(cells[i]);
+            hot[i].velocity.w = 0.0f; // Awake (the sleep counter, see cell_sleep.cpp)
+            accelerations[i] = cells[i].acceleration;
+            cold[i] = getCellCold(cells[i], divisionClock);
         }
+    }, 4096);
+
+    glNamedBufferSubData(cellHotBuffer, firstIndex * sizeof(CellHot), count * sizeof(CellHot), hot.data());
+    glNamedBufferSubData(cellAccelerationBuffer, firstIndex * sizeof(glm::vec4), count * sizeof(glm::vec4), accelerations.data());
+    // Velocity Verlet starts the written cells over from their velocity
+    glClearNamedBufferSubData(cellCarriedAccelerationBuffer, GL_R32UI, firstIndex * sizeof(glm::vec4), count * sizeof(glm::vec4),
+        GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    for (int i = 0; i < 2; i++)
+    {
+        glNamedBufferSubData(cellColdBuffer[i], firstIndex * sizeof(CellCold), count * sizeof(CellCold), cold.data());
     }
+
+    // The written cells may split at other times than the wheel has them
+    invalidateDivisionSchedule();
 }
 
 // ============================================================================
@@ -558,38 +886,364 @@ void CellManager::updateCells(float deltaTime)
         invalidateStatisticsCache();
     }
 
-    if (totalCellCount > 0) // Don't update cells if there are no cells to update
+    recordTick(deltaTime);
+}
+
+// Batched stepping
+// Fast-forwarding (time scrubber, keyframes, genome resimulation) runs thousands of ticks in a row. A batch
+// records them back to back: the passes are sized on the GPU anyway, so the count readback is left for the
+// end, and the GPU timers (which wait for their queries after every pass) are switched off meanwhile.
+// Only two things in a tick need the CPU to see GPU results, and a batch works around both:
+// - Neighbour lists rely on the CPU cell count to tell when new cells have no list yet, so a batch collides
+//   through the grid every tick and the lists are rebuilt on the next updateCells().
+// - A Morton reorder reads back the selected cell's new index, so while a cell is selected the reorder
+//   waits for the next updateCells().
+
+void CellManager::stepMany(int ticks, float deltaTime)
+{
+    if (ticks <= 0)
+        return;
+
+    beginBatch();
+    for (int i = 0; i < ticks; i++)
     {
-        // Flush barriers before starting compute pipeline
-        flushBarriers();
+        recordTick(deltaTime);
+    }
+    endBatch();
+}
+
+void CellManager::advanceTime(float duration, float timeStep)
+{
+    if (duration <= 0.0f || timeStep <= 0.0f)
+        return;
+
+    int ticks = static_cast<int>(duration / timeStep);
+    float remainder = duration - ticks * timeStep;
+
+    beginBatch();
+    for (int i = 0; i < ticks; i++)
+    {
+        recordTick(timeStep);
+    }
+    // Skip what is only float residue of the division
+    if (remainder > timeStep * 1e-4f)
+    {
+        recordTick(remainder);
+    }
+    endBatch();
+}
 
-        // Update spatial grid before physics
+void CellManager::beginBatch()
+{
+    TimerManager& timers = TimerManager::instance();
+    batchGPUTimersEnabled = timers.areGPUTimersEnabled();
+    timers.setGPUTimersEnabled(false);
+    recordingBatch = true;
+
+    clearBarriers();
+
+    if (pendingCellCount > 0)
+    {
+        addStagedCellsToQueueBuffer();
+    }
+
+    // Only the (non-blocking) count refresh; the ticks don't use it
+    updateCounts();
+    invalidateNeighborLists();
+}
+
+void CellManager::endBatch()
+{
+    recordingBatch = false;
+    TimerManager::instance().setGPUTimersEnabled(batchGPUTimersEnabled);
+
+    // The one sync of the batch: the final counts can only be copied once every tick has run
+    TimerCPU timer("Batch Sync");
+    waitForCounts();
+    invalidateStatisticsCache();
+}
+
+void CellManager::recordTick(float deltaTime)
+{
+    // The passes below are sized on the GPU from the current counters, which may be ahead of totalCellCount
+    // (e.g. divisions of the last tick), so the tick doesn't depend on the readback
+    runDispatchArgs();
+
+    // The UI and the bench can switch features on at any time
+    disableUnavailableFeatures();
+
+    // This tick's reductions for the adaptive time step start over
+    timestepTick++;
+    timestepClock += deltaTime;
+    tickEndTimes[timestepTick % config::ADAPTIVE_TIME_STEP_HISTORY] = timestepClock;
+    previousTimeStep = lastTimeStep;
+    lastTimeStep = deltaTime;
+    adaptiveTimeStep = plannedTimeStep;
+    resetTimestepStats();
+
+    // Flush barriers before starting compute pipeline
+    flushBarriers();
+
+    // Every few ticks, sort cell storage so that neighbours sit close together in memory. Dead cells are
+    // compacted away first, because the reorder only moves the cells in the grid (see cell_death.cpp)
+    bool reorderNeedsReadback = recordingBatch && selectedCell.isValid;
+    bool reorderDue = mortonReorderInterval > 0 && !reorderNeedsReadback && ++ticksSinceReorder >= mortonReorderInterval;
+    bool compactionDue = cellCompactionInterval > 0 && ++ticksSinceCompaction >= cellCompactionInterval &&
+        totalCellCount > liveCellCount;
+    compactionDue = compactionDue || cellCompactionPending;
+    if (!reorderNeedsReadback && (reorderDue || compactionDue))
+    {
+        ticksSinceCompaction = 0;
+        compactCells(); // This handles its own barriers internally
+    }
+    if (reorderDue)
+    {
+        ticksSinceReorder = 0;
+        reorderCells(); // This handles its own barriers internally
+    }
+
+    // Update spatial grid before physics; with neighbour lists, only when the lists have to be rebuilt
+    if (!useNeighborLists || recordingBatch)
+    {
+        invalidateNeighborLists();
         updateSpatialGrid(); // This handles its own barriers internally
+    }
+    else
+    {
+        if (neighborListsNeedRebuild())
+        {
+            updateSpatialGrid();
+
+            addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            flushBarriers();
+
+            buildNeighborLists();
+        }
 
         addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        flushBarriers();
+
+        runNeighborListCheck(deltaTime);
+    }
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Physics and integration only run over the awake cells (this also resizes their dispatches)
+    if (useSleeping)
+    {
+        runSleepCompaction();
+    }
 
+    if (useFusedPhysics)
+    {
+        // Collision forces and integration in a single pass (writes the back hot buffer, then swaps)
+        runFusedPhysicsCompute(deltaTime);
+    }
+    else
+    {
         // Run physics computation on GPU (reads from previous, writes to current)
-        runPhysicsCompute(deltaTime);
+        runPhysicsCompute();
 
         addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
         // Run position/velocity update on GPU (still working on current buffer)
         runUpdateCompute(deltaTime);
+    }
 
-        addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-        // Run cells' internal calculations (this creates new pending cells from mitosis)
-        runInternalUpdateCompute(deltaTime);
-        
-        // Single barrier after all simulation compute operations
-        addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    // Gather every cell's adhesions for the division schedule and the internal update
+    buildAdhesionAdjacency();
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // List the cells due to split by the end of this tick (this also resizes the internal update's dispatch)
+    runDivisionSchedule();
+
+    // Run cells' internal calculations (this creates new pending cells from mitosis)
+    runInternalUpdateCompute();
+    
+    // Single barrier after all simulation compute operations
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Culling and extraction cover the daughters as well
+    runDispatchArgs();
+
+    // Copy the tick's reductions for getNextTimeStep() (dropped while the ring is full; a later tick's will do)
+    if (useAdaptiveTimeStep)
+    {
+        addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        flushBarriers();
+        timestepStatsReadback.request(timestepStatsBuffer);
+    }
+}
+
+// Counter readback
+// The counters are copied into a ring of fenced, persistently mapped slots (AsyncReadback) and only read
+// once the GPU has finished the copy, so reading them never stalls the pipeline and never sees a half
+// written copy. Nothing on the GPU depends on them (every pass is sized by indirect dispatch).
+
+void CellManager::updateCounts()
+{
+    // The counters were last written by shaders; the copy reads them as a buffer
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    countReadback.request(gpuCellCountBuffer);
+
+    if (countReadback.poll())
+    {
+        applyCountReadback();
+    }
+    if (activeCountReadback.poll())
+    {
+        activeCellCount = static_cast<int>(*static_cast<const GLuint*>(activeCountReadback.getLatest()));
+    }
+}
+
+void CellManager::waitForCounts()
+{
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    if (!countReadback.request(gpuCellCountBuffer))
+    {
+        // Ring full: make room for a copy of the current values
+        countReadback.wait();
+        countReadback.request(gpuCellCountBuffer);
+    }
+    countReadback.wait();
+    applyCountReadback();
+
+    // The awake count of the last recorded tick (nothing new while sleeping is off)
+    activeCountReadback.wait();
+    activeCellCount = static_cast<int>(*static_cast<const GLuint*>(activeCountReadback.getLatest()));
+}
+
+void CellManager::discardCountReadbacks()
+{
+    countReadback.discard();
+}
+
+void CellManager::applyCountReadback()
+{
+    const GLuint* counts = static_cast<const GLuint*>(countReadback.getLatest());
+    totalCellCount = counts[0];
+    liveCellCount = counts[1];
+    totalAdhesionCount = counts[2]; // This is the number of adhesion connections, not cells
+    liveAdhesionCount = counts[3];
+}
+
+// Adaptive time step
+// The step only has to be as short as the fastest, most accelerated or most squeezed cell needs, so a sparse
+// colony runs on long ticks and a dense, overlapping one on short ones. The GPU reduces those extremes
+// every tick and the CPU picks the step from the newest finished copy, never waiting for one.
+
+void CellManager::resetTimestepStats()
+{
+    TimestepStats stats;
+    stats.minTimeToSplit = std::numeric_limits<float>::infinity();
+    stats.tick = timestepTick;
+    glNamedBufferSubData(timestepStatsBuffer, 0, sizeof(stats), &stats);
+}
+
+void CellManager::discardTimestepStats()
+{
+    timestepStatsReadback.discard();
+    firstValidTimestepTick = timestepTick + 1;
+    adaptiveTimeStep = config::physicsTimeStep;
+    plannedTimeStep = config::physicsTimeStep;
+}
+
+float CellManager::getNextTimeStep()
+{
+    if (!useAdaptiveTimeStep)
+    {
+        return config::physicsTimeStep;
+    }
+
+    timestepStatsReadback.poll();
+    const TimestepStats& stats = getTimestepStats();
+    uint32_t ticksAgo = timestepTick - stats.tick;
+    if (stats.tick < firstValidTimestepTick || ticksAgo >= config::ADAPTIVE_TIME_STEP_HISTORY)
+    {
+        // Nothing recent enough to go by (just started, reset or restored): the fixed step until there is
+        plannedTimeStep = config::physicsTimeStep;
+        return plannedTimeStep;
+    }
+
+    // No cell moves more than the displacement limit: the fastest one at its speed, the most accelerated one
+    // from rest
+    float timeStep = config::ADAPTIVE_TIME_STEP_MAX;
+    if (stats.maxSpeed > 0.0f)
+    {
+        timeStep = std::min(timeStep, config::ADAPTIVE_MAX_DISPLACEMENT / stats.maxSpeed);
     }
+    if (stats.maxAcceleration > 0.0f)
+    {
+        timeStep = std::min(timeStep, std::sqrt(2.0f * config::ADAPTIVE_MAX_DISPLACEMENT / stats.maxAcceleration));
+    }
+
+    // Cells pushed into each other deeper than the limit: shrink the step in proportion until they separate
+    if (stats.maxOverlap > config::ADAPTIVE_MAX_OVERLAP)
+    {
+        timeStep = std::min(timeStep, adaptiveTimeStep * config::ADAPTIVE_MAX_OVERLAP / stats.maxOverlap);
+    }
+
+    // Grow gradually, the stats being a few ticks old
+    timeStep = std::min(timeStep, adaptiveTimeStep * config::ADAPTIVE_TIME_STEP_GROWTH);
+    timeStep = std::clamp(timeStep, config::ADAPTIVE_TIME_STEP_MIN, config::ADAPTIVE_TIME_STEP_MAX);
+    plannedTimeStep = timeStep;
+
+    // End the tick on the next split rather than past it. The time to it was measured at the end of the
+    // copied tick, so what was simulated since comes off. A split that is due (or only float residue away)
+    // from the copy's point of view has already happened.
+    double sinceStats = timestepClock - tickEndTimes[stats.tick % config::ADAPTIVE_TIME_STEP_HISTORY];
+    double timeToSplit = static_cast<double>(stats.minTimeToSplit) - sinceStats;
+    if (timeToSplit > config::ADAPTIVE_TIME_STEP_MIN * 0.01 && timeToSplit < timeStep)
+    {
+        // A hair past the split time, so rounding of the ages can't leave the split for the next tick; the
+        // split carries the excess into the daughters' ages, so they stay exact either way
+        timeStep = static_cast<float>(timeToSplit) * 1.00001f;
+    }
+
+    return timeStep;
 }
 
 // ============================================================================
 // COMPUTE SHADER DISPATCH
 // ============================================================================
 
+void CellManager::runDispatchArgs()
+{
+    TimerGPU timer("Dispatch Args");
+
+    // The counters (and the occupied list length) may have just been written by a shader
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    dispatchArgsShader->use();
+    dispatchArgsShader->setInt("u_scanBlockSize", config::GRID_SCAN_BLOCK_SIZE);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, occupiedGridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, dispatchArgsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, activeCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, divisionStateBuffer);
+
+    dispatchArgsShader->dispatch(1, 1, 1);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Indirect dispatches read the arguments as commands, which needs its own barrier
+    addBarrier(GL_COMMAND_BARRIER_BIT);
+    flushBarriers();
+}
+
+void CellManager::dispatchIndirect(Shader* shader, DispatchArgsSlot slot)
+{
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, dispatchArgsBuffer);
+    shader->dispatchIndirect(static_cast<GLintptr>(slot) * 3 * sizeof(GLuint));
+}
+
 void CellManager::renderCells(glm::vec2 resolution, Shader &cellShader, Camera &camera, bool wireframe)
 {
     // Use unified culling system if any culling is enabled
@@ -636,12 +1290,12 @@ void CellManager::renderCells(glm::vec2 resolution, Shader &cellShader, Camera &
             extractShader->use();
 
             // Bind current buffers for compute shader (read from current cell buffer, write to current instance buffer)
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
             glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, modeBuffer);
             glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, instanceBuffer); // Dispatch extract compute shader
             glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer); // Bind GPU cell count buffer
-            GLuint numGroups = (totalCellCount + 255) / 256; // Updated to 256 for consistency
-            extractShader->dispatch(numGroups, 1, 1);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, getCellColdReadBuffer()); // Mode and orientation
+            dispatchIndirect(extractShader, DISPATCH_CELLS_256); // Updated to 256 for consistency
             
             // Add barrier for instance extraction but don't flush yet
             addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
@@ -681,7 +1335,7 @@ void CellManager::renderCells(glm::vec2 resolution, Shader &cellShader, Camera &
             cellShader.setVec3("uSelectedCellPos", glm::vec3(-9999.0f)); // Invalid position
             cellShader.setFloat("uSelectedCellRadius", 0.0f);
         }
-        cellShader.setFloat("uTime", static_cast<float>(glfwGetTime())); // Enable depth testing for proper 3D rendering (don't clear here - already done in main loop)
+        cellShader.setFloat("uTime", static_cast<float>(getProgramTime())); // Enable depth testing for proper 3D rendering (don't clear here - already done in main loop)
         glEnable(GL_DEPTH_TEST);
         
         // Enable back face culling for better performance
@@ -718,7 +1372,7 @@ void CellManager::renderCells(glm::vec2 resolution, Shader &cellShader, Camera &
     }
 }
 
-void CellManager::runPhysicsCompute(float deltaTime)
+void CellManager::runPhysicsCompute()
 {
     TimerGPU timer("Cell Physics Compute");
 
@@ -734,23 +1388,29 @@ void CellManager::runPhysicsCompute(float deltaTime)
     physicsShader->setInt("u_gridResolution", config::GRID_RESOLUTION);
     physicsShader->setFloat("u_gridCellSize", config::GRID_CELL_SIZE);
     physicsShader->setFloat("u_worldSize", config::WORLD_SIZE);
-    physicsShader->setInt("u_maxCellsPerGrid", config::MAX_CELLS_PER_GRID); // Bind buffers (read from previous buffer, write to current buffer for stable simulation)
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer()); // Read from previous frame
+    physicsShader->setInt("u_gridHashSize", useHashedGrid ? gridHashBucketCount : 0);
+    physicsShader->setInt("u_gridLevels", getGridLevelCount());
+    physicsShader->setInt("u_useNeighborList", useNeighborLists && neighborListCellCount > 0 ? 1 : 0);
+    physicsShader->setInt("u_neighborListCellCount", neighborListCellCount);
+    // Bind buffers (positions in, accelerations out; cold data isn't needed at all)
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridCountBuffer);
-
-    // Also bind current buffer as output for physics results
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, getCellWriteBuffer()); // Write to current frame
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, cellAccelerationBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gpuCellCountBuffer); // Bind GPU cell count buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, gridParamsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, neighborCountBuffer); // Neighbour lists (unused without them)
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, neighborOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, neighborIndexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, timestepStatsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, activeCellBuffer);
+    setSleepUniforms(physicsShader);
 
     // Dispatch compute shader - OPTIMIZED for 256 work group size
-    GLuint numGroups = (totalCellCount + 255) / 256; // Changed from 64 to 256 for better GPU utilization
-    physicsShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(physicsShader, getSimulatedCellsSlot());
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-
-    // Swap buffers for next frame
-    rotateBuffers();
 }
 
 void CellManager::runUpdateCompute(float deltaTime)
@@ -762,50 +1422,118 @@ void CellManager::runUpdateCompute(float deltaTime)
     // Set uniforms
     updateShader->setFloat("u_deltaTime", deltaTime);
     updateShader->setFloat("u_damping", 0.98f);
+    updateShader->setFloat("u_worldBounds", getWorldBounds());
+    updateShader->setInt("u_integrator", static_cast<int>(integrator));
+    updateShader->setFloat("u_previousDeltaTime", previousTimeStep);
+    updateShader->setInt("u_tick", static_cast<int>(timestepTick));
 
     // Pass dragged cell index to skip its position updates
     int draggedIndex = (isDraggingCell && selectedCell.isValid) ? selectedCell.cellIndex : -1;
-    updateShader->setInt("u_draggedCellIndex", draggedIndex); // Bind current cell buffer for in-place updates
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellWriteBuffer());
+    updateShader->setInt("u_draggedCellIndex", draggedIndex);
+    // Bind the hot buffer for in-place updates
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellAccelerationBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer); // Bind GPU cell count buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, timestepStatsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, activeCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, cellCarriedAccelerationBuffer);
+    setSleepUniforms(updateShader);
 
     // Dispatch compute shader - OPTIMIZED for 256 work group size
-    GLuint numGroups = (totalCellCount + 255) / 256; // Changed from 64 to 256 for better GPU utilization
-    updateShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(updateShader, getSimulatedCellsSlot());
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void CellManager::runFusedPhysicsCompute(float deltaTime)
+{
+    TimerGPU timer("Cell Physics Fused Compute");
+
+    fusedPhysicsShader->use();
+
+    // Pass dragged cell index to skip its physics and position updates
+    int draggedIndex = (isDraggingCell && selectedCell.isValid) ? selectedCell.cellIndex : -1;
+    fusedPhysicsShader->setInt("u_draggedCellIndex", draggedIndex);
+
+    // Set spatial grid uniforms
+    fusedPhysicsShader->setInt("u_gridResolution", config::GRID_RESOLUTION);
+    fusedPhysicsShader->setFloat("u_gridCellSize", config::GRID_CELL_SIZE);
+    fusedPhysicsShader->setFloat("u_worldSize", config::WORLD_SIZE);
+    fusedPhysicsShader->setInt("u_gridHashSize", useHashedGrid ? gridHashBucketCount : 0);
+    fusedPhysicsShader->setInt("u_gridLevels", getGridLevelCount());
+    fusedPhysicsShader->setInt("u_useNeighborList", useNeighborLists && neighborListCellCount > 0 ? 1 : 0);
+    fusedPhysicsShader->setInt("u_neighborListCellCount", neighborListCellCount);
+
+    // Integration uniforms, same as runUpdateCompute
+    fusedPhysicsShader->setFloat("u_deltaTime", deltaTime);
+    fusedPhysicsShader->setFloat("u_damping", 0.98f);
+    fusedPhysicsShader->setFloat("u_worldBounds", getWorldBounds());
+    fusedPhysicsShader->setInt("u_integrator", static_cast<int>(integrator));
+    fusedPhysicsShader->setFloat("u_previousDeltaTime", previousTimeStep);
+    fusedPhysicsShader->setInt("u_tick", static_cast<int>(timestepTick));
+
+    // Bind buffers (this tick's positions in, next tick's positions and velocities out)
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, cellHotBackBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gpuCellCountBuffer); // Bind GPU cell count buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, gridParamsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, neighborCountBuffer); // Neighbour lists (unused without them)
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, neighborOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, neighborIndexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, timestepStatsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, activeCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 12, cellCarriedAccelerationBuffer);
+    setSleepUniforms(fusedPhysicsShader);
+
+    // Every awake cell has to reach the back buffer before the swap, including cells added by last tick's
+    // internal update that the CPU hasn't read back yet, which the GPU-written dispatch size covers (sleeping
+    // cells are there already)
+    dispatchIndirect(fusedPhysicsShader, getSimulatedCellsSlot());
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-    // Swap buffers for next frame
-    rotateBuffers();
+    std::swap(cellHotBuffer, cellHotBackBuffer);
 }
 
-void CellManager::runInternalUpdateCompute(float deltaTime)
+void CellManager::runInternalUpdateCompute()
 {
     TimerGPU timer("Cell Internal Update Compute");
 
     internalUpdateShader->use();
 
     // Set uniforms
-    internalUpdateShader->setFloat("u_deltaTime", deltaTime);
-    internalUpdateShader->setInt("u_maxCells", cellLimit);
+    internalUpdateShader->setFloat("u_divisionClock", getDivisionClock());
+    internalUpdateShader->setFloat("u_epochEnd", (divisionEpochSlots - 1) * divisionSlotWidth);
     internalUpdateShader->setInt("u_maxAdhesions", cellLimit*config::MAX_ADHESIONS_PER_CELL/2);
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, modeBuffer);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellReadBuffer());
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, getCellWriteBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellColdReadBuffer()); // Own cell and new children, in place
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, divisionStateBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, adhesionConnectionBuffer);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, freeCellSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, divisionWordBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, freeAdhesionSlotBuffer);
-
-    // Dispatch compute shader - OPTIMIZED for 256 work group size
-    GLuint numGroups = (totalCellCount + 255) / 256; // Changed from 64 to 256 for better GPU utilization
-    internalUpdateShader->dispatch(numGroups, 1, 1);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, cellHotBuffer); // Only own cell and new children, in place
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, adhesionCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, adhesionOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, adhesionNeighborBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, timestepStatsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 12, divisionSplitBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 13, getDivisionRetryWriteBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 14, divisionAdhesionNeedBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 15, freeCellSlotBuffer);
+
+    // Only the cells that split this tick
+    dispatchIndirect(internalUpdateShader, DISPATCH_DIVISIONS_256);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-    // Swap buffers for next frame
-    rotateBuffers();
+    commitDivisions();
+
+    // What was retried or born this tick is next tick's retry list
+    divisionRetryIndex = 1 - divisionRetryIndex;
 }
 
 void CellManager::applyCellAdditions()
@@ -817,20 +1545,38 @@ void CellManager::applyCellAdditions()
     // Set uniforms
     cellAdditionShader->setInt("u_maxCells", cellLimit);
     cellAdditionShader->setInt("u_pendingCellCount", pendingCellCount);
+    cellAdditionShader->setFloat("u_divisionClock", getDivisionClock());
+    // Until the wheel is (re)built there is no epoch and no retry list yet; the rebuild lists every cell
+    cellAdditionShader->setFloat("u_epochEnd", divisionScheduleDirty ? -std::numeric_limits<float>::infinity() : (divisionEpochSlots - 1) * divisionSlotWidth);
 
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellAdditionBuffer);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellReadBuffer());
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, getCellWriteBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellColdReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, getCellColdWriteBuffer());
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, cellAccelerationBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, modeBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, getDivisionRetryReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, cellCarriedAccelerationBuffer);
 
     // Dispatch compute shader
     GLuint numGroups = (pendingCellCount + 63) / 64;
     cellAdditionShader->dispatch(numGroups, 1, 1);
 
+    // Every invocation placed its cell after the old count, so the count only goes up once all of them ran
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    cellAdditionCountShader->use();
+    cellAdditionCountShader->setInt("u_maxCells", cellLimit);
+    cellAdditionCountShader->setInt("u_pendingCellCount", pendingCellCount);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpuCellCountBuffer);
+    cellAdditionCountShader->dispatch(1, 1, 1);
+
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-    
-    // CRITICAL FIX: Rotate buffers after adding cells to ensure they're in the correct buffer for next frame
-    rotateBuffers();
+
+    // No swap: new cells were written to both cold buffers
+    // The wheel doesn't know about them; the ones due within the epoch went on the retry list instead
 }
 
 // ============================================================================
@@ -848,8 +1594,11 @@ void CellManager::resetSimulation()
     totalAdhesionCount = 0;
     liveAdhesionCount = 0;
     
-    // CRITICAL FIX: Reset buffer rotation state for consistent keyframe restoration
-    bufferRotation = 0;
+    // CRITICAL FIX: Reset cold buffer state for consistent keyframe restoration
+    coldBufferIndex = 0;
+    ticksSinceReorder = 0;
+    ticksSinceCompaction = 0;
+    cellCompactionPending = false;
     
     // Clear selection state
     clearSelection();
@@ -862,12 +1611,22 @@ void CellManager::resetSimulation()
     glNamedBufferSubData(gpuCellCountBuffer, sizeof(GLuint), sizeof(GLuint), &zero); // liveCellCount = 0
     glNamedBufferSubData(gpuCellCountBuffer, 2 * sizeof(GLuint), sizeof(GLuint), &zero); // totalAdhesionCount = 0
     glNamedBufferSubData(gpuCellCountBuffer, 3 * sizeof(GLuint), sizeof(GLuint), &zero); // liveAdhesionCount = 0
+    discardCountReadbacks(); // Copies in flight still hold the old counts
+    discardTimestepStats();
+    glClearNamedBufferSubData(activeCellBuffer, GL_R32UI, 0, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    activeCountReadback.discard();
+    activeCellCount = 0;
+    invalidateDivisionSchedule();
+    divisionTick = 0;
+    glClearNamedBufferData(dispatchArgsBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr); // Nothing to dispatch
     
     // Clear all cell buffers
-    for (int i = 0; i < 3; i++)
+    GLuint cellBuffers[] = { cellHotBuffer, cellHotBackBuffer, cellAccelerationBuffer, cellCarriedAccelerationBuffer,
+        cellCarriedAccelerationBackBuffer, cellColdBuffer[0], cellColdBuffer[1] };
+    for (GLuint buffer : cellBuffers)
     {
-        if (cellBuffer[i] != 0) {
-            glClearNamedBufferData(cellBuffer[i], GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        if (buffer != 0) {
+            glClearNamedBufferData(buffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
         }
     }
 
@@ -888,6 +1647,9 @@ void CellManager::resetSimulation()
         glClearNamedBufferData(cellAdditionBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
     }
     
+    // Neighbour lists refer to the old cells
+    invalidateNeighborLists();
+
     // Clear spatial grid buffers
     if (gridBuffer != 0) {
         glClearNamedBufferData(gridBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
@@ -898,11 +1660,8 @@ void CellManager::resetSimulation()
     if (gridOffsetBuffer != 0) {
         glClearNamedBufferData(gridOffsetBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
     }
-    if (gridHashBuffer != 0) {
-        glClearNamedBufferData(gridHashBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
-    }
-    if (activeCellsBuffer != 0) {
-        glClearNamedBufferData(activeCellsBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    if (occupiedGridCountBuffer != 0) {
+        glClearNamedBufferData(occupiedGridCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
     }
     
     // Clear adhesionSettings line buffer to prevent lingering lines after reset
@@ -931,6 +1690,7 @@ void CellManager::resetSimulation()
         }
         lodInstanceCounts[i] = 0; // Reset CPU-side LOD counts
     }
+    lodCountReadback.discard(); // Copies in flight still count the old cells
     
     // Invalidate cache since LOD counts have been reset
     invalidateStatisticsCache();
@@ -957,31 +1717,56 @@ void CellManager::spawnCells(int count)
 {
     TimerCPU cpuTimer("Spawning Cells");
 
-    for (int i = 0; i < count && totalCellCount < cellLimit; ++i)
+    count = std::min(count, cellLimit - totalCellCount - pendingCellCount);
+    if (count <= 0)
     {
-        // Random position within spawn radius
-        float angle1 = static_cast<float>(rand()) / RAND_MAX * 2.0f * 3.14159f;
-        float angle2 = static_cast<float>(rand()) / RAND_MAX * 3.14159f;
-        float radius = static_cast<float>(rand()) / RAND_MAX * spawnRadius;
+        std::cout << "Warning: Maximum cell count reached!\n";
+        return;
+    }
 
-        glm::vec3 position = glm::vec3(
-            radius * sin(angle2) * cos(angle1),
-            radius * cos(angle2),
-            radius * sin(angle2) * sin(angle1));
+    // rand() isn't thread safe, so draw every random number up front (in the same order as before)
+    // and only build the cells in parallel
+    constexpr int RANDOMS_PER_CELL = 6;
+    std::vector<float> randoms(count * RANDOMS_PER_CELL);
+    for (float& value : randoms)
+    {
+        value = static_cast<float>(rand()) / RAND_MAX;
+    }
 
-        // Random velocity
-        glm::vec3 velocity = glm::vec3(
-            (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 5.0f,
-            (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 5.0f,
-            (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 5.0f); // Random mass and fixed radius of 1
-        //float mass = 1.0f + static_cast<float>(rand()) / RAND_MAX * 2.0f;
-        //float cellRadius = 1.0f; // All cells have the same radius of 1
+    size_t firstNewCell = cellStagingBuffer.size();
+    cellStagingBuffer.resize(firstNewCell + count);
 
-        ComputeCell newCell{};
-        newCell.positionAndMass = glm::vec4(position, 1.);
-        newCell.velocity = glm::vec4(velocity, 0.);
-        newCell.acceleration = glm::vec4(0.0f); // Reset acceleration
+    JobSystem::get().parallelFor(count, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            const float* r = &randoms[i * RANDOMS_PER_CELL];
+
+            // Random position within spawn radius
+            float angle1 = r[0] * 2.0f * 3.14159f;
+            float angle2 = r[1] * 3.14159f;
+            float radius = r[2] * spawnRadius;
+
+            glm::vec3 position = glm::vec3(
+                radius * sin(angle2) * cos(angle1),
+                radius * cos(angle2),
+                radius * sin(angle2) * sin(angle1));
+
+            // Random velocity
+            glm::vec3 velocity = glm::vec3(
+                (r[3] - 0.5f) * 5.0f,
+                (r[4] - 0.5f) * 5.0f,
+                (r[5] - 0.5f) * 5.0f);
+
+            // Same record addCellToStagingBuffer() would stage (radius forced to 1)
+            ComputeCell& newCell = cellStagingBuffer[firstNewCell + i];
+            newCell = ComputeCell{};
+            newCell.positionAndMass = glm::vec4(position, 1.);
+            newCell.velocity = glm::vec4(velocity, 0.);
+            newCell.acceleration = glm::vec4(0.0f); // Reset acceleration
+        }
+    }, 1024);
 
-        addCellToStagingBuffer(newCell);
-    }
+    cpuCells.insert(cpuCells.end(), cellStagingBuffer.begin() + firstNewCell, cellStagingBuffer.end());
+    pendingCellCount += count;
 }
\ No newline at end of file
@@ -10,9 +10,11 @@
 #include "../../rendering/core/mesh/sphere_mesh.h"
 #include "../cell/common_structs.h"
 #include "../../rendering/systems/frustum_culling.h"
+#include "../../utils/async_readback.h"
 
 // Forward declaration
 class Camera;
+struct SimulationSnapshot;
 
 // Ensure struct alignment is correct for GPU usage
 static_assert(sizeof(ComputeCell) % 16 == 0, "ComputeCell must be 16-byte aligned for GPU usage");
@@ -24,14 +26,39 @@ struct CellManager
     // This replaces the CPU-based vectors with GPU buffer objects
     // The compute shaders handle physics calculations and position updates
 
-    // GPU buffer objects - Triple buffered for performance
-    GLuint cellBuffer[3]{};         // SSBO for compute cell data (double buffered)
+    // GPU buffer objects - cell data split by access pattern (see CellHot/CellCold in common_structs.h)
+    GLuint cellHotBuffer{};          // SSBO of CellHot: position, mass, velocity (single buffered)
+    GLuint cellHotBackBuffer{};      // Output of the fused physics pass and the cell reorder, swapped with cellHotBuffer afterwards
+    GLuint cellAccelerationBuffer{}; // SSBO of vec4 accelerations, written by physics, read by update
+    GLuint cellCarriedAccelerationBuffer{};     // Velocity Verlet: every cell's acceleration of its last update, stamped with the tick
+    GLuint cellCarriedAccelerationBackBuffer{}; // Gather target of the reorder and compaction, swapped with it afterwards
+    GLuint cellColdBuffer[2]{};      // SSBO of CellCold: orientation, internal state (the second is the reorder's gather target)
+    int coldBufferIndex{};
     GLuint instanceBuffer{};        // VBO for instance rendering data
-    int bufferRotation{};
 
     // Cell count management
     GLuint gpuCellCountBuffer{};     // GPU-accessible cell count buffer
-    GLuint stagingCellCountBuffer{}; // CPU-accessible cell count buffer (no sync stalls)
+    AsyncReadback countReadback;     // Fenced ring of copies of gpuCellCountBuffer, read without stalling
+
+    // Indirect dispatch arguments (dispatch_args.comp): the passes over all cells, connections or occupied grid
+    // cells take their work group counts from the GPU counters, refreshed whenever those change (the start of
+    // a tick, every grid assign pass, divisions in the internal update). The CPU-side counts are only used for
+    // statistics and heuristics, so they can lag behind without losing cells.
+    enum DispatchArgsSlot
+    {
+        DISPATCH_CELLS_256,       // Every cell, 256 invocation work groups
+        DISPATCH_CELLS_64,        // Every cell, 64 invocation work groups
+        DISPATCH_ADHESIONS_256,   // Every adhesion connection slot in use, 256 invocation work groups
+        DISPATCH_ADHESIONS_64,    // Every adhesion connection slot in use, 64 invocation work groups
+        DISPATCH_OCCUPIED_256,    // Occupied grid cell list, 256 invocation work groups
+        DISPATCH_OCCUPIED_BLOCKS, // Occupied grid cell list, one work group per GRID_SCAN_BLOCK_SIZE entries
+        DISPATCH_ACTIVE_CELLS_256, // Awake cell list (useSleeping), 256 invocation work groups
+        DISPATCH_DIVISION_CANDIDATES_256, // This tick's division candidates, 256 invocation work groups
+        DISPATCH_DIVISIONS_256,   // This tick's splitting cells, 256 invocation work groups
+        DISPATCH_DIVISION_RANK,   // One work group if any cell splits or dies this tick, none otherwise
+        DISPATCH_ARGS_SLOT_COUNT
+    };
+    GLuint dispatchArgsBuffer{};     // DISPATCH_ARGS_SLOT_COUNT triples of work group counts
     GLuint cellAdditionBuffer{};     // Cell addition queue for GPU
 
 	GLuint freeCellSlotBuffer{}; // Buffer for tracking free slots in the cell buffer
@@ -46,14 +73,53 @@ struct CellManager
     GLuint modeBuffer{};
 
     // Spatial partitioning buffers - Double buffered
-    GLuint gridBuffer{};       // SSBO for grid cell data (stores cell indices)
+    GLuint gridBuffer{};       // SSBO of cell indices sorted by grid cell (one entry per cell)
     GLuint gridCountBuffer{};  // SSBO for grid cell counts
-    GLuint gridOffsetBuffer{}; // SSBO for grid cell starting offsets
+    GLuint gridOffsetBuffer{}; // SSBO for grid cell starting offsets (exclusive prefix sum of the counts)
+    GLuint gridBlockSumBuffer{};    // Total count of every GRID_SCAN_BLOCK_SIZE grid cells
+    GLuint gridBlockOffsetBuffer{}; // Prefix sum of the block totals
+    GLuint cellGridSlotBuffer{};    // Grid cell and slot of every cell (uvec2), from the assign pass
+    GLuint cellRemapBuffer{};       // New index of every cell after a reorder or compaction
+    GLuint cellCompactionBuffer{};  // Live cell count, then live cells before every 256 cells (see cell_death.cpp)
     
-    // PERFORMANCE OPTIMIZATION: Additional buffers for 100k cells
-    GLuint gridHashBuffer{};   // Hash-based lookup for sparse grids
-    GLuint activeCellsBuffer{}; // Buffer containing only active grid cells
-    uint32_t activeGridCount{0}; // Number of active grid cells
+    // Hashed sparse grid (useHashedGrid): the same counting sort, keyed by a hash of the unclamped grid
+    // coordinates instead of the dense grid index, so the world needs no walls and the grid buffers scale
+    // with cellLimit instead of world volume. The count and offset buffers are sized for either key space.
+    int gridHashBucketCount{0};  // Power of two
+
+    // Multi-level grid (useMultiLevelGrid): the dense grid plus coarser levels at power of two multiples of
+    // GRID_CELL_SIZE, all in one key space (config::gridLevelKeyOffset). Every cell is counted into the finest
+    // level whose grid cells are as wide as it is, and physics searches each level with a stencil sized for
+    // the cells that can be there, so tiny cells next to huge ones don't force a wide search over the fine
+    // grid or crowd into a coarse one.
+
+    // Occupied grid cells: the assign pass lists every grid cell (or bucket) it puts a cell into, and the
+    // next clear zeroes only those counts, so every count outside the list is always zero. The list is in
+    // no particular order and holds the keys of the current grid until the next updateSpatialGrid(), which
+    // also makes it a cheap way to visit the non-empty parts of the world (e.g. for culling).
+    GLuint occupiedGridCellBuffer{};  // Keys of the occupied grid cells (cellLimit entries)
+    GLuint occupiedGridCountBuffer{}; // Length of that list (one uint)
+
+    // Largest cell radius of the tick (float bits), reduced on the GPU before the grid is built. Physics
+    // widens its dense grid search (and the hashed grid its cell size) so that no contact is missed,
+    // whatever the cell masses grow to.
+    GLuint gridParamsBuffer{};
+
+    // Verlet neighbour lists (useNeighborLists): per-cell runs of nearby cell indices, built from the grid
+    // and reused until the displacement check says a cell may have moved half the skin. Allocated on the
+    // first build.
+    GLuint neighborCountBuffer{};      // List length of every cell
+    GLuint neighborOffsetBuffer{};     // Allocation cursor, then the first entry of every cell's list
+    GLuint neighborIndexBuffer{};      // The lists (neighborListCapacity entries)
+    GLuint neighborReferenceBuffer{};  // Position of every cell at the last build (vec4)
+    GLuint neighborListStateBuffer{};  // Build generation, largest displacement, overflow flag, listed cells
+    GLuint stagingNeighborListStateBuffer{};
+    GLuint* neighborListStatePtr = nullptr; // Persistently mapped copy of the state, a tick or two old
+    int neighborListCapacity{0};       // Entries wanted in the index buffer
+    int allocatedNeighborListCapacity{0};
+    uint32_t neighborListGeneration{0};
+    int neighborListCellCount{0};      // Cells listed by the last build, 0 = no valid lists
+    int ticksSinceNeighborListBuild{0};
 
     // Sphere mesh for instanced rendering
     SphereMesh sphereMesh;
@@ -71,6 +137,18 @@ struct CellManager
         config::defaultLodDistance3
     }; // Distance thresholds for LOD levels
     bool useLODSystem = config::defaultUseLodSystem;          // Enable/disable LOD system
+    bool useFusedPhysics = config::defaultUseFusedPhysics;    // Collision forces and integration in one dispatch
+    bool useHashedGrid = config::defaultUseHashedGrid;        // Hashed sparse grid over an unbounded world
+    bool useMultiLevelGrid = config::defaultUseMultiLevelGrid; // Power of two dense grid levels (ignored by the hashed grid)
+    int mortonReorderInterval = config::defaultMortonReorderInterval; // Ticks between Morton reorders, 0 = off
+    int ticksSinceReorder{0};
+    int cellCompactionInterval = config::defaultCellCompactionInterval; // Ticks between dead cell compactions, 0 = only before a reorder
+    int ticksSinceCompaction{0};
+    bool cellCompactionPending{false}; // Set by CPU-side bulk writes, which may have written dead cells
+    bool useNeighborLists = config::defaultUseNeighborLists;  // Verlet neighbour lists (see neighbor_list.cpp)
+    float neighborListSkin = config::defaultNeighborListSkin;
+    int neighborListMaxAge = config::defaultNeighborListMaxAge;
+    config::Integrator integrator = config::defaultIntegrator; // Velocity and position update of this scene
     
     // LOD instance buffers - separate buffer for each LOD level
     
@@ -78,7 +156,8 @@ struct CellManager
     Shader* unifiedCullShader = nullptr;      // Unified compute shader for all culling modes
     Shader* distanceFadeShader = nullptr;     // Vertex/fragment shaders for distance-based fading
     GLuint unifiedOutputBuffers[4]{};         // Output buffers for each LOD level
-    GLuint unifiedCountBuffer{};              // Buffer for LOD counts
+    GLuint unifiedCountBuffer{};              // glDrawElementsIndirect command per LOD level (instance counts from culling)
+    AsyncReadback lodCountReadback;           // Copies of those commands, for the LOD statistics
     bool useFrustumCulling = config::defaultUseFrustumCulling;            // Enable/disable frustum culling
     bool useDistanceCulling = config::defaultUseDistanceCulling;          // Enable/disable distance-based culling
     Frustum currentFrustum;                   // Current camera frustum
@@ -107,15 +186,48 @@ struct CellManager
     // Compute shaders
     Shader* physicsShader = nullptr;
     Shader* updateShader = nullptr;
+    Shader* fusedPhysicsShader = nullptr; // Physics + update in one pass (see useFusedPhysics)
     Shader* extractShader = nullptr; // For extracting instance data efficiently
     Shader* internalUpdateShader = nullptr;
     Shader* cellAdditionShader = nullptr;
+    Shader* cellAdditionCountShader = nullptr; // Counts the added cells once all of them are placed
 
     // Spatial partitioning compute shaders
+    Shader* gridMaxRadiusShader = nullptr; // Reduce the largest cell radius
     Shader* gridClearShader = nullptr;     // Clear grid counts
     Shader* gridAssignShader = nullptr;    // Assign cells to grid
-    Shader* gridPrefixSumShader = nullptr; // Calculate grid offsets
+    Shader* gridPrefixSumShader = nullptr; // Calculate grid offsets (block scan)
+    Shader* gridPrefixAddShader = nullptr; // Add the scanned block totals to the grid offsets
+    Shader* gridOccupiedScanShader = nullptr; // Calculate the offsets of the occupied grid cells only (block scan)
+    Shader* gridOccupiedAddShader = nullptr;  // Add the scanned block totals to those offsets
     Shader* gridInsertShader = nullptr;    // Insert cells into grid
+    Shader* gridRankShader = nullptr;      // Rank every cell by index within its grid cell
+
+    // Neighbour list shaders
+    Shader* neighborListBuildShader = nullptr;
+    Shader* neighborListCheckShader = nullptr;
+
+    // Cell reorder shaders (Morton order, see reorderCells)
+    Shader* cellReorderGatherShader = nullptr;
+    Shader* cellReorderRemapShader = nullptr;
+
+    // Dead cell compaction shaders (see cell_death.cpp)
+    Shader* cellCompactCountShader = nullptr;
+    Shader* cellCompactScanShader = nullptr;
+    Shader* cellCompactGatherShader = nullptr;
+
+    Shader* dispatchArgsShader = nullptr; // Writes dispatchArgsBuffer from the GPU counters
+    Shader* cellSleepShader = nullptr;    // Sleeping cells and the awake cell list (useSleeping)
+
+    // Division timing wheel shaders (division_schedule.cpp)
+    Shader* divisionWheelCountShader = nullptr;   // Rebases birth times, counts the cells of every slot
+    Shader* divisionWheelScanShader = nullptr;    // Slot offsets
+    Shader* divisionWheelScatterShader = nullptr; // Lists the cells by slot
+    Shader* divisionWheelRemapShader = nullptr;   // Renumbers the wheel and retry list after a reorder or compaction
+    Shader* divisionScheduleShader = nullptr;     // This tick's candidates
+    Shader* divisionDecideShader = nullptr;       // Which candidates split
+    Shader* divisionRankScanShader = nullptr;     // Ranks of the splitting cells
+    Shader* divisionCommitShader = nullptr;       // Counters and free stack after the splits
     
     // CPU-side storage for initialization and debugging
     // Note: cpuCells is deprecated in favor of GPU buffers, should be removed after refactoring
@@ -123,29 +235,71 @@ struct CellManager
     std::vector<ComputeCell> cellStagingBuffer;
     
     // Cell count tracking (CPU-side approximation of GPU state)
+    // The counts are the latest copy of gpuCellCountBuffer the GPU has finished (see updateCounts()), so they
+    // usually trail the GPU by a tick or two; getCountsAge() says by how many
     int totalCellCount{ 0 };    // Approximate cell count, may not reflect exact GPU state due to being a frame behind
 	int liveCellCount{ 0 };     // Number of live cells (not dead or pending)
 	int totalAdhesionCount{ 0 };     // Total number of adhesion connections
     int liveAdhesionCount{ 0 };     // Number of live adhesion connections
     int pendingCellCount{ 0 };  // Number of cells pending addition by CPU
-    void* mappedPtr = nullptr;      // Pointer to the cell count staging buffer
-    GLuint* countPtr = nullptr;     // Typed pointer to the mapped buffer value
-    void syncCounterBuffers()
-    {
-        glCopyNamedBufferSubData(gpuCellCountBuffer, stagingCellCountBuffer, 0, 0, sizeof(GLuint) * config::COUNTER_NUMBER);
-    }
-    void updateCounts()
-    {
-        syncCounterBuffers();
-
-        // Add buffer update barrier but don't flush yet
-        addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
-
-        totalCellCount = countPtr[0];
-        liveCellCount = countPtr[1];
-        totalAdhesionCount = countPtr[2]; // This is the number of adhesion connections, not cells
-        liveAdhesionCount = countPtr[3]; 
-    }
+    void updateCounts();        // Queues a copy of the counters and takes any finished ones (never waits)
+    void waitForCounts();       // Exact counts: waits for the GPU (benchmarks, the end of a stepMany batch)
+    void discardCountReadbacks(); // After the CPU wrote the counters itself; copies in flight are older
+    int getCountsAge() const { return countReadback.getAge(); } // Count requests since the current counts were copied
+
+    // Adaptive time step (useAdaptiveTimeStep)
+    // Every tick, physics, the update and the division schedule reduce the fastest cell, the largest acceleration,
+    // the deepest overlap and the shortest time until a cell splits into timestepStatsBuffer (TimestepStats).
+    // getNextTimeStep() picks the largest step those allow from the newest copy the GPU has finished: no cell
+    // moves more than ADAPTIVE_MAX_DISPLACEMENT, the step shrinks while cells overlap deeper than
+    // ADAPTIVE_MAX_OVERLAP, and it never passes the next split, so divisions happen on the tick they are due.
+    // The copy is usually a few ticks old; the time simulated since then is taken off the time to the split.
+    GLuint timestepStatsBuffer{};
+    AsyncReadback timestepStatsReadback;
+    bool useAdaptiveTimeStep = config::defaultUseAdaptiveTimeStep;
+    float getNextTimeStep();    // Step for the next updateCells() (config::physicsTimeStep when not adaptive)
+    float getLastTimeStep() const { return lastTimeStep; }
+    const TimestepStats& getTimestepStats() const { return *static_cast<const TimestepStats*>(timestepStatsReadback.getLatest()); }
+
+    // Sleeping cells (useSleeping, see cell_sleep.cpp)
+    // A cell that stays slower than SLEEP_SPEED and less accelerated than SLEEP_ACCELERATION for SLEEP_TICKS
+    // ticks falls asleep: physics and integration skip it until a moving cell touches it or it is about to
+    // split. Every tick lists the awake cells first and physics and the update passes run over that list, so
+    // a mature colony that is mostly resting bulk only pays for its growth front.
+    GLuint activeCellBuffer{};          // Awake cell count, then their indices
+    AsyncReadback activeCountReadback;  // Copies of the count, for statistics
+    bool useSleeping = config::defaultUseSleeping;
+    bool sleepingAvailable{true};       // False when cell_sleep.comp failed to link; useSleeping is then kept off
+    int activeCellCount{ 0 };           // Awake cells, as of the latest finished copy
+
+    // Division timing wheel (see division_schedule.cpp)
+    // Every cell's split time is fixed at birth, so cells are sorted into time slots by when they split and
+    // each tick only visits the slots that came due. The wheel is rebuilt once per epoch (at most
+    // DIVISION_WHEEL_SLOTS slots, no longer than the shortest split interval) and whenever cells were written
+    // or renumbered; in between, a tick costs O(divisions) instead of O(cells).
+    GLuint divisionSlotCountBuffer{};   // Cells per slot
+    GLuint divisionSlotOffsetBuffer{};  // Where each slot starts in divisionWheelBuffer
+    GLuint divisionCellSlotBuffer{};    // Slot and rank within the slot of every cell (uvec2)
+    GLuint divisionWheelBuffer{};       // Cell indices, by slot
+    GLuint divisionStateBuffer{};       // This tick's candidate and split counts, then what the splits took
+    GLuint divisionRetryBuffer[2]{};    // Count, then cells to check again next tick (read, write)
+    int divisionRetryIndex{ 0 };
+    GLuint divisionSplitBuffer{};       // This tick's splitting cells
+    GLuint divisionWordBuffer{};        // Split and death bits and offsets of every 32 cells (2 uvec4), for the ranks
+    GLuint divisionWordSummaryBuffer{}; // One bit per division word with a split or death in it this tick
+    GLuint divisionWordListBuffer{};    // Those words in index order, from the rank scan
+    GLuint divisionAdhesionNeedBuffer{}; // Adhesion slots each splitting cell takes and gives back (uvec2)
+    uint32_t divisionTick{ 0 };         // Ticks since the reset, seeds the priority between adhered splits
+    double divisionEpochOrigin{ 0.0 };  // timestepClock at the last rebuild: 0 on the division clock
+    float divisionSlotWidth = config::physicsTimeStep;
+    int divisionEpochSlots{ 1 };        // Slots of the current epoch; slot divisionEpochSlots holds the later splits
+    int nextDivisionSlot{ 0 };          // First slot not yet handed out as candidates
+    float divisionMinSplitInterval{ 0.0f }; // Shortest split interval (or lifespan) of the genome, bounds the epoch
+    bool divisionScheduleDirty{ true };
+    // Simulation time now, measured from divisionEpochOrigin. Birth times on the GPU are kept on this clock, so
+    // that they stay precise as floats; CellCold::birthTime converts to and from ComputeCell::age with it.
+    float getDivisionClock() const { return static_cast<float>(timestepClock - divisionEpochOrigin); }
+    void invalidateDivisionSchedule() { divisionScheduleDirty = true; } // Cells were written, or the genome changed
 
     // Configuration
     static constexpr int DEFAULT_CELL_COUNT = config::DEFAULT_CELL_COUNT;
@@ -189,6 +343,14 @@ struct CellManager
     GLuint adhesionConnectionBuffer{};  // Buffer storing permanent adhesionSettings connections
     Shader* adhesionPhysicsShader = nullptr;  // Compute shader for processing adhesionSettings physics
 
+    // Adhesion adjacency (CSR), rebuilt from the connection buffer every tick
+    GLuint adhesionCountBuffer{};     // Active connections per cell
+    GLuint adhesionOffsetBuffer{};    // Allocation cursor, then the first neighbour entry of every cell
+    GLuint adhesionNeighborBuffer{};  // AdhesionNeighbor entries, two per active connection
+    Shader* adhesionAdjacencyCountShader = nullptr;
+    Shader* adhesionAdjacencyOffsetsShader = nullptr;
+    Shader* adhesionAdjacencyFillShader = nullptr;
+
     void initializeGizmoBuffers();
     void updateGizmoData();
     void cleanupGizmos();
@@ -207,6 +369,7 @@ struct CellManager
     void cleanupAdhesionLines();
 
     void initializeAdhesionConnectionSystem();
+    void buildAdhesionAdjacency();
     void runAdhesionPhysics();
     void cleanupAdhesionConnectionSystem();
 
@@ -216,8 +379,10 @@ struct CellManager
     void addCellsToQueueBuffer(const std::vector<ComputeCell> &cells);
     void addCellToStagingBuffer(const ComputeCell &newCell);
     void addStagedCellsToQueueBuffer();
-    void addGenomeToBuffer(GenomeData& genomeData) const;
+    void addGenomeToBuffer(const GenomeData& genomeData);
     void updateCells(float deltaTime);
+    void stepMany(int ticks, float deltaTime);             // Records N ticks back to back and syncs once at the end
+    void advanceTime(float duration, float timeStep);      // stepMany over duration, plus one shorter last tick
     void cleanup();
 
     // Spatial partitioning functions
@@ -268,6 +433,7 @@ struct CellManager
     const SelectedCellInfo &getSelectedCell() const { return selectedCell; }
     ComputeCell getCellData(int index) const;
     void updateCellData(int index, const ComputeCell &newData); // Needs refactoring
+    void writeCellsToGPU(int firstIndex, const ComputeCell* cells, int count); // Splits into hot/cold and writes every cell buffer
 
     // Memory barrier optimization system
     // Forward declaration and performance monitoring
@@ -340,35 +506,27 @@ struct CellManager
     const BarrierStats& getBarrierStats() const { return barrierStats; }
     void resetBarrierStats() const { barrierStats.reset(); }
 
-    // Triple buffering management functions
-    int getRotatedIndex(int index, int max) const { return (index + bufferRotation) % max; }
-    void rotateBuffers() { bufferRotation = getRotatedIndex(1, 3); }
-    GLuint getCellReadBuffer() const { return cellBuffer[getRotatedIndex(0, 3)]; }
-    GLuint getCellWriteBuffer() const { return cellBuffer[getRotatedIndex(1, 3)]; }
+    // Cell buffer access
+    GLuint getCellHotBuffer() const { return cellHotBuffer; }
+    GLuint getCellAccelerationBuffer() const { return cellAccelerationBuffer; }
+    GLuint getCellColdReadBuffer() const { return cellColdBuffer[coldBufferIndex]; }
+    GLuint getCellColdWriteBuffer() const { return cellColdBuffer[1 - coldBufferIndex]; }
+    void swapColdBuffers() { coldBufferIndex = 1 - coldBufferIndex; }
     // BUFFER ACCESS RULES:
-	// NEVER write to the read buffer directly, because that will be overwritten by the next shader pass
-    // Read from the read buffer and write to the write buffer
-	// Rotate buffers after each shader pass that writes to them to ensure correct read/write access
-	// Do not rotate buffers when you don't need to write to them; this will undo the previous shader pass
-	// All threads write to the write buffer, even if some don't have new data to write. This is to ensure that the write buffer is always fully updated.
-
-    // Minor exception:
-	// If each thread reads and writes to and from the same single cell, and only that cell, then you can use the read buffer for both reading and writing.
-	// This is useful for operations that only affect a single cell, like dragging or selection.
-	// This is fine for operations that occur independently of other cells, like updating cells' positions.
-	// Do not rotate the buffers after this operation, as it will undo the previous shader pass.
-	// If you are unsure if you can use this exception, do not use it.
-	// If there are weird bugs when using this exception, try not using it and see if the bugs go away.
-
-    // Frame |  Write   | Read | Standby
-    //     1 |    B0    |  B1  |   B2
-    //     2 |    B2    |  B0  |   B1
-    //     3 |    B1    |  B2  |   B0
-
-	// Frame | B0 | B1 | B2
-	//     1 |  W |  R |  S
-	//     2 |  R |  S |  W
-	//     3 |  S |  W |  R
+    // The hot buffer (position, mass, velocity) is single buffered and updated in place. This is only safe
+    // because every pass that writes it writes nothing but the invocation's own cell (or a freshly claimed
+    // cell index nobody else reads), and no pass reads another cell's hot data while the same pass writes it.
+    // Physics reads neighbour positions, so it must only write the acceleration buffer (and the dragged
+    // cell's velocity, which no one reads during physics, and the sleep counter of a neighbour it wakes).
+    // The fused physics pass both reads neighbour positions and moves its own cell, so it writes the back
+    // hot buffer instead and the two are swapped afterwards; always bind getCellHotBuffer() at bind time.
+    //
+    // The cold buffer is updated in place as well. The internal update reads adhered neighbours' split times
+    // to decide which cells split, so that decision is its own pass (division_decide.comp) before the split
+    // pass writes anything; the split pass only touches its own cell and its new child.
+	// NEVER write to the cold read buffer in a pass that reads other cells' cold data
+    // The second cold buffer is the target of the reorder's gather, which swaps the two afterwards
+	// Passes that write cold data from the CPU or the addition queue write both cold buffers
 
     void setCellLimit(int limit) { cellLimit = limit; }
     int getCellLimit() const { return cellLimit; }
@@ -402,16 +560,86 @@ struct CellManager
     // Adhesion connection methods for keyframe support
     std::vector<AdhesionConnection> getAdhesionConnections() const; // Get current adhesion connections
     void restoreAdhesionConnections(const std::vector<AdhesionConnection> &connections, int count); // Restore adhesion connections
+    int rebuildFreeAdhesionSlots(const AdhesionConnection* connections, int count); // Free stack from the inactive ones, returns the live count
+
+    // Shows a state simulated elsewhere (SimulationThread) instead of running ticks here
+    void presentSnapshot(const SimulationSnapshot& snapshot);
 
 private:
-    void runPhysicsCompute(float deltaTime);
+    void runPhysicsCompute();
     void runUpdateCompute(float deltaTime);
-    void runInternalUpdateCompute(float deltaTime);
+    void runFusedPhysicsCompute(float deltaTime); // Replaces the two passes above when useFusedPhysics is set
+    void runInternalUpdateCompute();                // Splits the cells that are due (after runDivisionSchedule)
     void applyCellAdditions();
 
     // Spatial grid helper functions
-    void runGridClear();
-    void runGridAssign();
-    void runGridPrefixSum();
+    int getGridLevelCount() const { return useMultiLevelGrid && !useHashedGrid ? config::GRID_LEVEL_COUNT : 1; }
+    int getGridKeyCount() const
+    {
+        if (useHashedGrid) return gridHashBucketCount;
+        return getGridLevelCount() > 1 ? config::TOTAL_MULTI_LEVEL_GRID_CELLS : config::TOTAL_GRID_CELLS;
+    }
+    float getWorldBounds() const { return useHashedGrid ? 0.0f : config::WORLD_SIZE * 0.5f; } // 0 = no walls
+    // The grid passes are shared with the cell reorder, which sorts by Morton code over the whole buffer
+    void runGridMaxRadius();                            // Fills gridParamsBuffer
+    void runGridClear();                                // Zeroes the counts of the occupied grid cells
+    void runGridAssign(bool mortonKeys);                // Also refreshes the occupied list dispatch sizes
+    void runGridPrefixSum(int gridKeyCount);            // Key ordered offsets of every grid cell
+    void runGridOccupiedPrefixSum();                    // Offsets of the occupied grid cells, in list order
     void runGridInsert();
+
+    void applyCountReadback();                              // Latest finished counter copy -> the CPU-side counts
+
+    // Adaptive time step
+    void resetTimestepStats();                              // Starts this tick's reductions, tagged with its number
+    void discardTimestepStats();                            // After the state was replaced; older stats no longer apply
+    uint32_t timestepTick{ 0 };                             // Ticks recorded so far
+    uint32_t firstValidTimestepTick{ 1 };                   // Stats of earlier ticks describe a discarded state
+    double timestepClock{ 0.0 };                            // Simulation time recorded so far
+    double tickEndTimes[config::ADAPTIVE_TIME_STEP_HISTORY]{}; // timestepClock at the end of each recent tick
+    float lastTimeStep = config::physicsTimeStep;           // Step of the last tick recorded
+    float previousTimeStep = config::physicsTimeStep;       // Step of the tick before that (velocity Verlet)
+    float adaptiveTimeStep = config::physicsTimeStep;       // Controller step of the last tick, before landing on a split
+    float plannedTimeStep = config::physicsTimeStep;        // Controller step getNextTimeStep() picked for the next tick
+
+    void disableUnavailableFeatures();                      // Turns off toggles whose programs failed to link
+
+    // Indirect dispatch
+    void runDispatchArgs();                                 // Rewrites dispatchArgsBuffer from the GPU counters
+    void dispatchIndirect(Shader* shader, DispatchArgsSlot slot);
+
+    // Sleeping cells (cell_sleep.cpp)
+    void runSleepCompaction();                              // Puts quiet cells to sleep and lists the awake ones
+    void setSleepUniforms(Shader* shader) const;            // u_sleepTicks etc. of the physics and update passes
+    int getSleepTicks() const { return useSleeping ? config::SLEEP_TICKS : 0; } // u_sleepTicks, 0 = off
+    DispatchArgsSlot getSimulatedCellsSlot() const { return useSleeping ? DISPATCH_ACTIVE_CELLS_256 : DISPATCH_CELLS_256; }
+
+    // Division timing wheel (division_schedule.cpp)
+    void initializeDivisionSchedule();
+    void runDivisionSchedule();                             // Lists this tick's splits, rebuilding the wheel when needed
+    void rebuildDivisionWheel();                            // New epoch starting at this tick's end
+    void remapDivisionWheel();                              // Renumbers the wheel through cellRemapBuffer
+    void commitDivisions();                                 // Moves the counters past the splits (after the split pass)
+    int getDivisionSlot(float divisionClock) const;         // Slot due at that time (divisionEpochSlots: after the epoch)
+    GLuint getDivisionRetryReadBuffer() const { return divisionRetryBuffer[divisionRetryIndex]; }
+    GLuint getDivisionRetryWriteBuffer() const { return divisionRetryBuffer[1 - divisionRetryIndex]; }
+    void cleanupDivisionSchedule();
+
+    // Cell reorder (cell_reorder.cpp)
+    void reorderCells();
+    void compactCells(); // Moves the live cells to the front, dropping the dead ones (cell_death.cpp)
+
+    // Verlet neighbour lists (neighbor_list.cpp)
+    bool neighborListsNeedRebuild();
+    void buildNeighborLists();
+    void runNeighborListCheck(float deltaTime);
+    void invalidateNeighborLists() { neighborListCellCount = 0; }
+    void cleanupNeighborLists();
+
+    // Batched stepping (stepMany, advanceTime)
+    void recordTick(float deltaTime);                       // Every pass of one tick, without touching the counts
+    void beginBatch();
+    void endBatch();
+    bool recordingBatch{ false };
+    bool batchGPUTimersEnabled{ true };                     // TimerManager setting to restore after the batch
 };
@@ -0,0 +1,120 @@
+#include "cell_manager.h"
+#include "../../core/config.h"
+#include <utility>
+#include "../../utils/timer.h"
+
+// Cell storage reordering
+// New cells are appended wherever a slot is free, so after a while spatial neighbours are scattered over
+// the cell buffers and every neighbour gather in physics, culling and extraction misses the cache.
+// reorderCells() sorts the cells by the Morton (Z-order) code of their grid cell, which keeps cells that
+// are close in space close in memory. The sort is the grid counting sort with Morton keys instead of grid
+// indices; the grid is rebuilt from scratch right afterwards, so reusing its buffers is free.
+//
+// Everything that refers to cells by index is remapped: the adhesion connections and the division wheel (on
+// the GPU) and the selected cell (read back, only while a cell is selected). The adhesion adjacency is rebuilt from the
+// connections every tick and needs nothing, and the neighbour lists are invalidated and rebuilt.
+// Accelerations aren't moved, because physics rewrites them before anything reads them. Sleep counters live
+// in the hot data and move with it, but sleeping cells also need the back hot buffer in the new order.
+void CellManager::reorderCells()
+{
+    if (totalCellCount == 0)
+        return;
+    TimerGPU timer("Cell Reorder");
+
+    // A cell missing from the permutation would be lost, so every dispatch is sized by the GPU cell count
+    // (dispatchArgsBuffer), never the CPU-side one, which may be behind. The Morton keys go on the occupied
+    // grid cell list like any others, but the permutation needs key order, so this is the one place that
+    // scans the whole grid.
+    runGridClear();
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    runGridAssign(true);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    runGridPrefixSum(config::TOTAL_GRID_CELLS);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    runGridInsert();
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Move the cells into sorted order (hot and the carried accelerations to the back buffers, cold to the
+    // write buffer)
+    {
+        TimerGPU gatherTimer("Cell Reorder Gather");
+
+        cellReorderGatherShader->use();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellHotBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, cellHotBackBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, getCellColdReadBuffer());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, getCellColdWriteBuffer());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, cellRemapBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, gpuCellCountBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, cellCarriedAccelerationBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, cellCarriedAccelerationBackBuffer);
+
+        dispatchIndirect(cellReorderGatherShader, DISPATCH_CELLS_256);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        std::swap(cellHotBuffer, cellHotBackBuffer);
+        std::swap(cellCarriedAccelerationBuffer, cellCarriedAccelerationBackBuffer);
+        swapColdBuffers();
+    }
+
+    // The fused pass skips sleeping cells, so both hot buffers must hold them (see cell_sleep.cpp)
+    if (useSleeping)
+    {
+        addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        flushBarriers();
+        glCopyNamedBufferSubData(cellHotBuffer, cellHotBackBuffer, 0, 0, cellLimit * sizeof(CellHot));
+    }
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Point the adhesion connections at the new indices
+    {
+        TimerGPU remapTimer("Cell Reorder Remap");
+
+        cellReorderRemapShader->use();
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, adhesionConnectionBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellRemapBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+
+        dispatchIndirect(cellReorderRemapShader, DISPATCH_ADHESIONS_256);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        // The division wheel and retry list as well
+        remapDivisionWheel();
+    }
+
+    // The selected (or dragged) cell has moved as well; this is the only readback, and only while a
+    // cell is selected
+    if (selectedCell.isValid && selectedCell.cellIndex >= 0 && selectedCell.cellIndex < cellLimit)
+    {
+        addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        flushBarriers();
+
+        GLuint newIndex = 0;
+        glGetNamedBufferSubData(cellRemapBuffer, selectedCell.cellIndex * sizeof(GLuint), sizeof(GLuint), &newIndex);
+        selectedCell.cellIndex = static_cast<int>(newIndex);
+    }
+
+    // Neighbour lists hold the old indices
+    invalidateNeighborLists();
+
+    // Let the caller's next pass see the reordered buffers
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
@@ -2,7 +2,10 @@
 #include "../../rendering/camera/camera.h"
 #include "../../core/config.h"
 #include "../../ui/ui_manager.h"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
@@ -16,6 +19,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include "../../utils/timer.h"
+#include "../../utils/job_system.h"
 
 void CellManager::handleMouseInput(const glm::vec2 &mousePos, const glm::vec2 &screenSize,
     const Camera &camera, bool isMousePressed, bool isMouseDown,
@@ -100,12 +104,21 @@ int CellManager::selectCellAtPosition(const glm::vec3 &rayOrigin, const glm::vec
 {
 float closestDistance = FLT_MAX;
 int closestCellIndex = -1;
-int intersectionCount = 0;
+std::atomic<int> intersectionCount{ 0 };
+std::mutex closestMutex;
 
 // Debug output for raycasting
 std::cout << "Testing " << totalCellCount << " cells for intersection..." << std::endl;
 
-for (int i = 0; i < totalCellCount; i++)
+// Every range finds its own closest hit, then merges it into the overall one.
+// Equal distances go to the lower index, so the result doesn't depend on how the ranges were split.
+JobSystem::get().parallelFor(totalCellCount, [&](int begin, int end)
+{
+float rangeClosestDistance = FLT_MAX;
+int rangeClosestIndex = -1;
+int rangeIntersections = 0;
+
+for (int i = begin; i < end; i++)
 {
 glm::vec3 cellPosition = glm::vec3(cpuCells[i].positionAndMass);
 float cellRadius = cpuCells[i].getRadius();
@@ -113,19 +126,30 @@ float cellRadius = cpuCells[i].getRadius();
 float intersectionDistance;
 if (raySphereIntersection(rayOrigin, rayDirection, cellPosition, cellRadius, intersectionDistance))
 {
-intersectionCount++;
-std::cout << "Cell " << i << " at (" << cellPosition.x << ", " << cellPosition.y << ", " << cellPosition.z
-<< ") radius " << cellRadius << " intersected at distance " << intersectionDistance << std::endl;
+rangeIntersections++;
 
-if (intersectionDistance < closestDistance && intersectionDistance > 0)
+if (intersectionDistance < rangeClosestDistance && intersectionDistance > 0)
 {
-closestDistance = intersectionDistance;
-closestCellIndex = i;
+rangeClosestDistance = intersectionDistance;
+rangeClosestIndex = i;
 }
 }
 }
 
-std::cout << "Found " << intersectionCount << " intersections total" << std::endl;
+intersectionCount.fetch_add(rangeIntersections, std::memory_order_relaxed);
+if (rangeClosestIndex < 0)
+return;
+
+std::lock_guard<std::mutex> lock(closestMutex);
+if (rangeClosestDistance < closestDistance ||
+(rangeClosestDistance == closestDistance && rangeClosestIndex < closestCellIndex))
+{
+closestDistance = rangeClosestDistance;
+closestCellIndex = rangeClosestIndex;
+}
+}, 2048);
+
+std::cout << "Found " << intersectionCount.load() << " intersections total" << std::endl;
 if (closestCellIndex >= 0)
 {
 std::cout << "Selected closest cell " << closestCellIndex << " at distance " << closestDistance << std::endl;
@@ -156,13 +180,7 @@ cpuCells[selectedCell.cellIndex].velocity.z = 0.0f; // Update cached selected ce
 selectedCell.cellData = cpuCells[selectedCell.cellIndex];
 
 // Update GPU buffers immediately to ensure compute shaders see the new position
-for (int i = 0; i < 3; i++)
-{
-glNamedBufferSubData(cellBuffer[i],
-selectedCell.cellIndex * sizeof(ComputeCell),
-sizeof(ComputeCell),
-&cpuCells[selectedCell.cellIndex]);
-}
+writeCellsToGPU(selectedCell.cellIndex, &cpuCells[selectedCell.cellIndex], 1);
 }
 
 void CellManager::clearSelection()
@@ -180,13 +198,7 @@ if (isDraggingCell && selectedCell.isValid)
 cpuCells[selectedCell.cellIndex].velocity.x = 0.0f;
 cpuCells[selectedCell.cellIndex].velocity.y = 0.0f;
 cpuCells[selectedCell.cellIndex].velocity.z = 0.0f; // Update the GPU buffers with the final state
-for (int i = 0; i < 3; i++)
-{
-glNamedBufferSubData(cellBuffer[i],
-  selectedCell.cellIndex * sizeof(ComputeCell),
-  sizeof(ComputeCell),
-  &cpuCells[selectedCell.cellIndex]);
-}
+writeCellsToGPU(selectedCell.cellIndex, &cpuCells[selectedCell.cellIndex], 1);
 }
 
 isDraggingCell = false;
@@ -201,8 +213,13 @@ return;
 addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 flushBarriers();
 
-// Copy data from GPU buffer to staging buffer (no GPU->CPU transfer warning)
-glCopyNamedBufferSubData(getCellReadBuffer(), stagingCellBuffer, 0, 0, totalCellCount * sizeof(ComputeCell));
+// Copy data from the GPU buffers to the staging buffer (no GPU->CPU transfer warning)
+// Staging layout: hot records, then accelerations, then cold records, each sized for cellLimit cells
+const size_t accelerationOffset = static_cast<size_t>(cellLimit) * sizeof(CellHot);
+const size_t coldOffset = accelerationOffset + static_cast<size_t>(cellLimit) * sizeof(glm::vec4);
+glCopyNamedBufferSubData(cellHotBuffer, stagingCellBuffer, 0, 0, totalCellCount * sizeof(CellHot));
+glCopyNamedBufferSubData(cellAccelerationBuffer, stagingCellBuffer, 0, accelerationOffset, totalCellCount * sizeof(glm::vec4));
+glCopyNamedBufferSubData(getCellColdReadBuffer(), stagingCellBuffer, 0, coldOffset, totalCellCount * sizeof(CellCold));
 
 // Memory barrier to ensure copy is complete
 addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
@@ -220,22 +237,27 @@ glFinish();
 }
 
 // Now read from the staging buffer (CPU->CPU, no warning)
-ComputeCell* stagedData = static_cast<ComputeCell*>(mappedCellPtr);
+char* stagedData = static_cast<char*>(mappedCellPtr);
 
 if (stagedData)
 {
-cpuCells.reserve(totalCellCount);
-// Copy data from staging buffer to CPU storage
-for (int i = 0; i < totalCellCount; i++)
+const CellHot* stagedHot = reinterpret_cast<const CellHot*>(stagedData);
+const glm::vec4* stagedAccelerations = reinterpret_cast<const glm::vec4*>(stagedData + accelerationOffset);
+const CellCold* stagedCold = reinterpret_cast<const CellCold*>(stagedData + coldOffset);
+
+if (cpuCells.size() < static_cast<size_t>(totalCellCount))
 {
-if (i < cpuCells.size())
+cpuCells.resize(totalCellCount);
+}
+// Reassemble full cells from the staged parts into CPU storage
+const float divisionClock = getDivisionClock();
+JobSystem::get().parallelFor(totalCellCount, [&](int begin, int end)
 {
-cpuCells[i] = stagedData[i]; // Sync all data
-} else
+for (int i = begin; i < end; i++)
 {
-cpuCells.push_back(stagedData[i]);
-}
+cpuCells[i] = combineCell(stagedHot[i], stagedAccelerations[i], stagedCold[i], divisionClock);
 }
+}, 4096);
 
 
 }
@@ -0,0 +1,62 @@
+#include "cell_manager.h"
+#include "../../core/config.h"
+#include "../../utils/timer.h"
+
+// Sleeping cells
+// In a mature colony most cells are resting bulk, squeezed into place with nothing moving them, and only the
+// growth front is busy. A cell that stays slower than SLEEP_SPEED with less than SLEEP_ACCELERATION of net
+// force for SLEEP_TICKS ticks falls asleep, and physics and integration skip it from then on. It still sits
+// in the grid, so awake cells keep colliding with it.
+//
+// The sleep counter is velocity.w of the hot data, which travels with the cell through the reorder, the
+// readback and the restore for free. The update (or fused) pass counts the quiet ticks of every cell it
+// integrates; at the start of the next tick cell_sleep.comp puts the cells that reached SLEEP_TICKS to sleep
+// and lists the awake ones, and physics and the update passes are dispatched over that list
+// (DISPATCH_ACTIVE_CELLS_256). A sleeper wakes when an awake cell at least as fast as SLEEP_SPEED touches it
+// (physics clears its counter), when it is within SLEEP_WAKE_BEFORE_SPLIT of its split (division_decide.comp),
+// while it is dragged, and whenever the CPU writes it.
+//
+// The fused pass writes the back hot buffer and skips sleepers, so a cell falling asleep is stopped and copied
+// into both hot buffers, and the swap never brings back an older copy. The Morton reorder refreshes the back
+// buffer the same way. The grid and the list itself still cover every cell, but they are a small part of a
+// tick next to physics.
+
+void CellManager::runSleepCompaction()
+{
+    TimerGPU timer("Cell Sleep");
+
+    // The list is rebuilt from scratch; its last readers were last tick's passes
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    glClearNamedBufferSubData(activeCellBuffer, GL_R32UI, 0, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    cellSleepShader->use();
+
+    int draggedIndex = (isDraggingCell && selectedCell.isValid) ? selectedCell.cellIndex : -1;
+    cellSleepShader->setInt("u_sleepTicks", config::SLEEP_TICKS);
+    cellSleepShader->setInt("u_draggedCellIndex", draggedIndex);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cellHotBackBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, activeCellBuffer);
+
+    dispatchIndirect(cellSleepShader, DISPATCH_CELLS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Size the dispatches over the list (this waits for the pass)
+    runDispatchArgs();
+
+    // The awake count, for statistics only (dropped while the ring is full)
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    activeCountReadback.request(activeCellBuffer);
+}
+
+void CellManager::setSleepUniforms(Shader* shader) const
+{
+    shader->setInt("u_sleepTicks", getSleepTicks());
+    shader->setFloat("u_sleepSpeed", config::SLEEP_SPEED);
+    shader->setFloat("u_sleepAcceleration", config::SLEEP_ACCELERATION);
+}
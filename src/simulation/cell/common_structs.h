@@ -24,7 +24,8 @@ struct ComputeCell {
     float age{ 0 };                     // also used for split timer
     float toxins{ 0 };
     float nitrates{ 1 };
-    int adhesionIndices[20]{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 ,-1, -1, -1, -1, };
+    // A cell's adhesions aren't stored in the cell: they are looked up through the AdhesionNeighbor
+    // adjacency that is rebuilt from the connection buffer every tick
 
     float getRadius() const
     {
@@ -32,6 +33,77 @@ struct ComputeCell {
     }
 };
 
+// On the GPU a ComputeCell is stored as three separate arrays, so every pass only streams what it uses:
+// the hot part (read by the grid, physics, update and every render pass), the acceleration written by
+// physics for the update pass, and the cold part (orientation and internal state) that mostly
+// only the internal update touches. ComputeCell stays the CPU-side and upload format.
+struct CellHot {
+    glm::vec4 positionAndMass{ 0, 0, 0, 1 };       // x, y, z, mass
+    glm::vec4 velocity{};
+};
+
+struct CellCold {
+    glm::quat orientation{ 1., 0., 0., 0. };
+    glm::quat angularVelocity{ 1., 0., 0., 0. };
+    glm::quat angularAcceleration{ 1., 0., 0., 0. };
+    glm::vec4 signallingSubstances{};
+    int modeIndex{ 0 };
+    float birthTime{ 0 };   // On the division clock (CellManager::getDivisionClock): age = clock - birthTime
+    float toxins{ 0 };
+    float nitrates{ 1 };
+};
+
+// Per-tick reductions for the adaptive time step (TimestepStatsBuffer in the physics, update and internal
+// update shaders). The shaders reduce the floats through their bits with atomicMax/atomicMin, which order
+// non-negative floats correctly; the CPU tags every tick's copy with the tick it belongs to.
+struct TimestepStats {
+    float maxSpeed{ 0 };
+    float maxAcceleration{ 0 };
+    float maxOverlap{ 0 };          // Fraction of the contact distance
+    float minTimeToSplit{ 0 };      // Simulation time from the end of the tick to the next split (+inf: none)
+    uint32_t tick{ 0 };
+    uint32_t padding[3]{};
+};
+
+static_assert(sizeof(CellHot) == 32 && sizeof(CellCold) == 80, "GPU cell layouts must match the shaders");
+static_assert(sizeof(CellHot) + sizeof(glm::vec4) + sizeof(CellCold) == sizeof(ComputeCell), "Split cell must cover ComputeCell");
+
+inline CellHot getCellHot(const ComputeCell& cell)
+{
+    return CellHot{ cell.positionAndMass, cell.velocity };
+}
+
+inline CellCold getCellCold(const ComputeCell& cell, float divisionClock)
+{
+    CellCold cold;
+    cold.orientation = cell.orientation;
+    cold.angularVelocity = cell.angularVelocity;
+    cold.angularAcceleration = cell.angularAcceleration;
+    cold.signallingSubstances = cell.signallingSubstances;
+    cold.modeIndex = cell.modeIndex;
+    cold.birthTime = divisionClock - cell.age;
+    cold.toxins = cell.toxins;
+    cold.nitrates = cell.nitrates;
+    return cold;
+}
+
+inline ComputeCell combineCell(const CellHot& hot, const glm::vec4& acceleration, const CellCold& cold, float divisionClock)
+{
+    ComputeCell cell;
+    cell.positionAndMass = hot.positionAndMass;
+    cell.velocity = hot.velocity;
+    cell.acceleration = acceleration;
+    cell.orientation = cold.orientation;
+    cell.angularVelocity = cold.angularVelocity;
+    cell.angularAcceleration = cold.angularAcceleration;
+    cell.signallingSubstances = cold.signallingSubstances;
+    cell.modeIndex = cold.modeIndex;
+    cell.age = divisionClock - cold.birthTime;
+    cell.toxins = cold.toxins;
+    cell.nitrates = cold.nitrates;
+    return cell;
+}
+
 struct AdhesionSettings
 {
     bool canBreak = true;
@@ -56,7 +128,7 @@ struct GPUMode {
     int parentMakeAdhesion{ 0 };  // Boolean flag for adhesionSettings creation (0 = false, 1 = true) + padding
     int childAKeepAdhesion{ 1 };
 	int childBKeepAdhesion{ 1 };
-	int padding[1]{ 0 }; // Padding to ensure 16-byte alignment for GPU compatibility
+	float lifespan{ 0. }; // Age at which the cell dies unless it splits first, 0 = never (see cell_death.cpp)
 };
 
 struct AdhesionConnection
@@ -67,11 +139,20 @@ struct AdhesionConnection
     uint32_t isActive;   // Whether the connection is currently active (1 = active, 0 = inactive)
 };
 
+// One entry of the per-tick adhesion adjacency (CSR): the active connections of cell i are the
+// entries [offsets[i], offsets[i] + counts[i]), each naming the cell on the other end.
+// Every active connection appears twice, once under each of its cells.
+struct AdhesionNeighbor
+{
+    uint32_t cellIndex;       // The other cell of the connection
+    uint32_t connectionIndex; // Index into the adhesion connection buffer
+};
+
 struct ChildSettings
 {
     int modeNumber = 0;
     glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); // quaternion, identity by default
-    bool keepAdhesion = false;
+    bool keepAdhesion = true; // Inherit the parent's adhesions
 };
 
 struct ModeSettings
@@ -81,6 +162,7 @@ struct ModeSettings
     bool parentMakeAdhesion = true;
     float splitMass = 1.0f;
     float splitInterval = 5.0f;
+    float lifespan = 0.0f; // Age at which the cell dies unless it splits first, 0 = never
     glm::vec2 parentSplitDirection = { 0.0f, 0.0f}; // pitch, yaw in degrees
 
     // Child Settings
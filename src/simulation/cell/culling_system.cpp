@@ -17,6 +17,16 @@
 #include <glm/gtx/quaternion.hpp>
 #include "../../utils/timer.h"
 
+// Layout glDrawElementsIndirect reads, one per LOD level in unifiedCountBuffer (DrawElementsCommand in unified_cull.comp)
+struct DrawElementsIndirectCommand
+{
+    GLuint indexCount;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
 void CellManager::initializeUnifiedCulling()
 {
     // Initialize unified culling compute shader
@@ -37,14 +47,15 @@ void CellManager::initializeUnifiedCulling()
         );
     }
     
-    // Create buffer for LOD counts
+    // Create buffer for the per-LOD draw commands (instance counts written by the culling pass)
     glCreateBuffers(1, &unifiedCountBuffer);
     glNamedBufferStorage(
         unifiedCountBuffer,
-        sizeof(uint32_t) * 4, // 4 LOD levels
+        sizeof(DrawElementsIndirectCommand) * 4, // 4 LOD levels
         nullptr,
-        GL_DYNAMIC_STORAGE_BIT | GL_MAP_READ_BIT
+        GL_DYNAMIC_STORAGE_BIT
     );
+    lodCountReadback.init(sizeof(DrawElementsIndirectCommand) * 4);
     
     std::cout << "Unified culling system initialized\n";
 }
@@ -74,6 +85,7 @@ void CellManager::cleanupUnifiedCulling()
         glDeleteBuffers(1, &unifiedCountBuffer);
         unifiedCountBuffer = 0;
     }
+    lodCountReadback.cleanup();
 }
 
 void CellManager::updateFrustum(const Camera& camera, float fov, float aspectRatio, float nearPlane, float farPlane)
@@ -92,9 +104,12 @@ void CellManager::runUnifiedCulling(const Camera& camera)
     
     unifiedCullShader->use();
     
-    // Clear count buffer before computation
-    uint32_t zeroCounts[4] = {0, 0, 0, 0};
-    glNamedBufferSubData(unifiedCountBuffer, 0, sizeof(zeroCounts), zeroCounts);
+    // Reset the draw commands: mesh index counts, no instances yet
+    DrawElementsIndirectCommand drawCommands[4]{};
+    for (int i = 0; i < 4; i++) {
+        drawCommands[i].indexCount = sphereMesh.getLODIndexCount(i);
+    }
+    glNamedBufferSubData(unifiedCountBuffer, 0, sizeof(drawCommands), drawCommands);
     
     // Set camera and distance culling uniforms
     unifiedCullShader->setVec3("u_cameraPos", camera.getPosition());
@@ -122,29 +137,37 @@ void CellManager::runUnifiedCulling(const Camera& camera)
     }
     
     // Bind buffers
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, modeBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, unifiedOutputBuffers[0]); // LOD 0
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, unifiedOutputBuffers[1]); // LOD 1
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, unifiedOutputBuffers[2]); // LOD 2
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, unifiedOutputBuffers[3]); // LOD 3
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, unifiedCountBuffer);      // LOD counts
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, unifiedCountBuffer);      // LOD draw commands
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, getCellColdReadBuffer()); // Mode and orientation
     
     // Dispatch compute shader
-    GLuint numGroups = (totalCellCount + 63) / 64;
-    unifiedCullShader->dispatch(numGroups, 1, 1);
-    
-    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    dispatchIndirect(unifiedCullShader, DISPATCH_CELLS_64);
     
-    // Read back LOD counts for rendering
-    glGetNamedBufferSubData(unifiedCountBuffer, 0, sizeof(lodInstanceCounts), lodInstanceCounts);
+    // The draws read the instances as vertex attributes and their counts as commands
+    addBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
     
-    // Invalidate cache since LOD counts have changed
-    invalidateStatisticsCache();
-    
-    // Calculate total visible cells for statistics
-    visibleCellCount = lodInstanceCounts[0] + lodInstanceCounts[1] + lodInstanceCounts[2] + lodInstanceCounts[3];
+    // The LOD counts are only needed for statistics, so they come from the latest finished copy
+    lodCountReadback.request(unifiedCountBuffer);
+    if (lodCountReadback.poll()) {
+        const DrawElementsIndirectCommand* counts = static_cast<const DrawElementsIndirectCommand*>(lodCountReadback.getLatest());
+        for (int i = 0; i < 4; i++) {
+            lodInstanceCounts[i] = static_cast<int>(counts[i].instanceCount);
+        }
+        
+        // Invalidate cache since LOD counts have changed
+        invalidateStatisticsCache();
+        
+        // Calculate total visible cells for statistics
+        visibleCellCount = lodInstanceCounts[0] + lodInstanceCounts[1] + lodInstanceCounts[2] + lodInstanceCounts[3];
+    }
 }
 
 void CellManager::renderCellsUnified(glm::vec2 resolution, const Camera& camera, bool wireframe)
@@ -195,7 +218,7 @@ void CellManager::renderCellsUnified(glm::vec2 resolution, const Camera& camera,
             distanceFadeShader->setVec3("uSelectedCellPos", glm::vec3(-9999.0f));
             distanceFadeShader->setFloat("uSelectedCellRadius", 0.0f);
         }
-        distanceFadeShader->setFloat("uTime", static_cast<float>(glfwGetTime()));
+        distanceFadeShader->setFloat("uTime", static_cast<float>(getProgramTime()));
         
         // Enable depth testing (no blending needed since we're not using transparency)
         glEnable(GL_DEPTH_TEST);
@@ -213,14 +236,13 @@ void CellManager::renderCellsUnified(glm::vec2 resolution, const Camera& camera,
         }
         
         // Render each LOD level with its appropriate mesh detail and instance data
+        // (the instance counts stay on the GPU, so every level is drawn, possibly with no instances)
         for (int lodLevel = 0; lodLevel < 4; lodLevel++) {
-            if (lodInstanceCounts[lodLevel] > 0) {
-                // Setup sphere mesh to use the unified output buffer with fade factor
-                sphereMesh.setupLODInstanceBufferWithFade(lodLevel, unifiedOutputBuffers[lodLevel]);
-                
-                // Render this LOD level with its specific mesh detail and instance count
-                sphereMesh.renderLOD(lodLevel, lodInstanceCounts[lodLevel], 0);
-            }
+            // Setup sphere mesh to use the unified output buffer with fade factor
+            sphereMesh.setupLODInstanceBufferWithFade(lodLevel, unifiedOutputBuffers[lodLevel]);
+            
+            // Render this LOD level with its specific mesh detail and the culling pass's instance count
+            sphereMesh.renderLODIndirect(lodLevel, unifiedCountBuffer, lodLevel * sizeof(DrawElementsIndirectCommand));
         }
         
         // Restore OpenGL state
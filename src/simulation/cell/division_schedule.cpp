@@ -0,0 +1,301 @@
+#include "cell_manager.h"
+#include "../../core/config.h"
+#include "../../utils/timer.h"
+#include <algorithm>
+#include <cmath>
+
+// Division timing wheel
+// A cell splits splitInterval after its birth, so its split time is known the moment it is born and never
+// changes. Instead of ageing every cell and checking all of them every tick, the cold data stores the birth
+// time, and the cells are bucketed by split time into the slots of a timing wheel, one physicsTimeStep wide.
+// A tick only hands out the slots that came due since the last tick, so the internal update runs over the
+// cells that split rather than over the colony.
+//
+// Birth times are on the division clock, the simulation time since the wheel's origin (getDivisionClock()),
+// which keeps them small enough to stay exact as floats. The CPU converts them from and to ComputeCell::age
+// wherever cells cross over (writeCellsToGPU, the readback, the addition queue).
+//
+// Every tick:
+// - division_schedule.comp picks the candidates: the due slots, then the retry list of the last tick.
+// - division_decide.comp checks them. A cell whose lifespan is shorter than its split interval is due at the
+//   end of its life instead, and dies rather than splits (see cell_death.cpp). Cells not due yet (their slot came early, or it was handed out ahead of
+//   time to wake sleeping cells) and adhered cells that lost the priority check go back on the retry list;
+//   the others are listed for the split.
+// - division_rank_scan.comp ranks the splitting and dying cells by index (see below).
+// - The internal update splits the listed cells in place, and kills the dying ones. Daughters due before the
+//   epoch ends go on the retry list, since the wheel only lists the cells that existed when it was built.
+// - division_commit.comp moves the cell and adhesion counters and the free stacks past what the splits took
+//   and gave back.
+//
+// The wheel covers one epoch, at most DIVISION_WHEEL_SLOTS slots and no longer than the shortest split
+// interval, so that few daughters split within the epoch they are born in; the last slot collects every
+// later split. When the due range would run past the epoch, or when cells were written or the genome changed,
+// the wheel is rebuilt from every cell with a count, scan and scatter, the birth times are moved to the new
+// origin, and the retry lists start over. That O(cells) rebuild happens once an epoch; the ticks in between
+// only cost O(divisions). Cells added from the queue go on the retry list like daughters when they are due
+// within the epoch, and a Morton reorder or compaction renumbers the slots not handed out yet and the retry
+// list in place (remapDivisionWheel()), so neither ends the epoch.
+//
+// The splits don't allocate anything with atomics, so the same state always splits the same way, into the
+// same slots, whatever order the GPU runs them in. The decision sets a bit per splitting (or dying) cell in
+// the division words (one record per 32 cells) and adds up the adhesion slots it takes and gives back; a scan
+// over the words turns that into every cell's rank, which gives its child's index and its adhesion slots, and
+// the counters move once all splits are done. The scan also drops the splits there is no room for. It only
+// visits the words that have a split or death in them, listed from a bitmap with a bit per word, and only those
+// words are cleared afterwards, so a tick doesn't touch a record per 32 cells; a tick without splits or
+// deaths skips the scan altogether. The priority check between adhered neighbours is seeded with
+// divisionTick, so it is reproducible as well.
+//
+// The schedule also feeds the adaptive time step: the candidates reduce their exact time to the split, and
+// the first occupied slot after the due range bounds the rest, so no pass has to scan every cell for that
+// either.
+
+void CellManager::initializeDivisionSchedule()
+{
+    glCreateBuffers(1, &divisionSlotCountBuffer);
+    glNamedBufferStorage(divisionSlotCountBuffer, (config::DIVISION_WHEEL_SLOTS + 1) * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &divisionSlotOffsetBuffer);
+    glNamedBufferStorage(divisionSlotOffsetBuffer, (config::DIVISION_WHEEL_SLOTS + 2) * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &divisionCellSlotBuffer);
+    glNamedBufferData(divisionCellSlotBuffer, cellLimit * sizeof(glm::uvec2), nullptr, GL_STREAM_COPY);
+    glCreateBuffers(1, &divisionWheelBuffer);
+    glNamedBufferData(divisionWheelBuffer, cellLimit * sizeof(GLuint), nullptr, GL_STREAM_COPY);
+    glCreateBuffers(1, &divisionStateBuffer);
+    glNamedBufferStorage(divisionStateBuffer, 9 * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    for (int i = 0; i < 2; i++)
+    {
+        glCreateBuffers(1, &divisionRetryBuffer[i]);
+        glNamedBufferStorage(divisionRetryBuffer[i], (cellLimit + 1) * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+    glCreateBuffers(1, &divisionSplitBuffer);
+    glNamedBufferData(divisionSplitBuffer, cellLimit * sizeof(GLuint), nullptr, GL_STREAM_COPY);
+    glCreateBuffers(1, &divisionWordBuffer);
+    glNamedBufferStorage(divisionWordBuffer, ((cellLimit + 31) / 32) * 2 * sizeof(glm::uvec4), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &divisionWordSummaryBuffer);
+    glNamedBufferStorage(divisionWordSummaryBuffer, (((cellLimit + 31) / 32 + 31) / 32) * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &divisionWordListBuffer);
+    glNamedBufferData(divisionWordListBuffer, ((cellLimit + 31) / 32) * sizeof(GLuint), nullptr, GL_STREAM_COPY);
+    glCreateBuffers(1, &divisionAdhesionNeedBuffer);
+    glNamedBufferData(divisionAdhesionNeedBuffer, cellLimit * sizeof(glm::uvec2), nullptr, GL_STREAM_COPY);
+
+    // dispatch_args.comp reads the candidate and split counts every time (nothing to do until the first tick)
+    glClearNamedBufferData(divisionStateBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    // From then on, every tick's words are cleared by the commit pass that ends it
+    glClearNamedBufferData(divisionWordBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glClearNamedBufferData(divisionWordSummaryBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    divisionScheduleDirty = true;
+}
+
+void CellManager::runDivisionSchedule()
+{
+    TimerGPU timer("Division Schedule");
+
+    // Sleeping cells are woken up a little ahead of their split, so their slots are handed out that early
+    float lookahead = useSleeping ? config::SLEEP_WAKE_BEFORE_SPLIT : 0.0f;
+    if (divisionScheduleDirty || getDivisionSlot(getDivisionClock() + lookahead) >= divisionEpochSlots)
+    {
+        rebuildDivisionWheel();
+    }
+    int lastSlot = std::min(getDivisionSlot(getDivisionClock() + lookahead), divisionEpochSlots - 1);
+
+    // Candidate range and fresh split and retry lists
+    divisionScheduleShader->use();
+    divisionScheduleShader->setInt("u_firstSlot", nextDivisionSlot);
+    divisionScheduleShader->setInt("u_lastSlot", lastSlot);
+    divisionScheduleShader->setInt("u_epochSlots", divisionEpochSlots);
+    divisionScheduleShader->setFloat("u_slotWidth", divisionSlotWidth);
+    divisionScheduleShader->setFloat("u_divisionClock", getDivisionClock());
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, divisionSlotCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, divisionSlotOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, divisionStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, getDivisionRetryReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, getDivisionRetryWriteBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, timestepStatsBuffer);
+
+    divisionScheduleShader->dispatch(1, 1, 1);
+
+    nextDivisionSlot = std::max(nextDivisionSlot, lastSlot + 1);
+
+    // Size the decision over the candidates (this waits for the pass)
+    runDispatchArgs();
+
+    // The words are zero: the last tick's commit cleared the ones it used
+    divisionDecideShader->use();
+    divisionDecideShader->setFloat("u_divisionClock", getDivisionClock());
+    divisionDecideShader->setInt("u_sleepTicks", getSleepTicks());
+    divisionDecideShader->setFloat("u_sleepWakeBeforeSplit", config::SLEEP_WAKE_BEFORE_SPLIT);
+    divisionDecideShader->setInt("u_frameNumber", static_cast<int>(divisionTick++));
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, modeBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellColdReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, divisionStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, divisionWheelBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, getDivisionRetryReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, getDivisionRetryWriteBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, divisionSplitBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, cellHotBuffer); // Only the sleep counter, in place
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, adhesionCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, adhesionOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, adhesionNeighborBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, timestepStatsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 12, divisionWordBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 13, divisionAdhesionNeedBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 14, divisionWordSummaryBuffer);
+
+    dispatchIndirect(divisionDecideShader, DISPATCH_DIVISION_CANDIDATES_256);
+
+    // Size the rank scan and the internal update over the splits (this waits for the pass)
+    runDispatchArgs();
+
+    // Ranks of the splitting and dying cells; not dispatched at all on a tick without any
+    divisionRankScanShader->use();
+    divisionRankScanShader->setInt("u_maxCells", cellLimit);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, divisionWordBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, divisionAdhesionNeedBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, divisionStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, divisionWordSummaryBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, divisionWordListBuffer);
+
+    dispatchIndirect(divisionRankScanShader, DISPATCH_DIVISION_RANK);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+}
+
+void CellManager::commitDivisions()
+{
+    // The split pass only read the counters and wrote the slots it gave back above the free stacks
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    divisionCommitShader->use();
+    divisionCommitShader->setInt("u_maxAdhesions", cellLimit * config::MAX_ADHESIONS_PER_CELL / 2);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, divisionStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, freeAdhesionSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, freeCellSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, divisionWordBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, divisionWordListBuffer);
+
+    divisionCommitShader->dispatch(1, 1, 1);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void CellManager::rebuildDivisionWheel()
+{
+    TimerGPU timer("Division Wheel Rebuild");
+
+    // The new epoch starts at the end of this tick, with as many slots as fit into the shortest split interval
+    float originShift = getDivisionClock();
+    divisionEpochOrigin = timestepClock;
+    divisionSlotWidth = config::physicsTimeStep;
+    int intervalSlots = static_cast<int>(divisionMinSplitInterval / divisionSlotWidth) + 1;
+    divisionEpochSlots = std::clamp(intervalSlots, 2, config::DIVISION_WHEEL_SLOTS);
+    nextDivisionSlot = 0;
+    divisionScheduleDirty = false;
+
+    // Every cell is in the wheel now, so nothing is left to retry
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    glClearNamedBufferData(divisionSlotCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    for (int i = 0; i < 2; i++)
+    {
+        glClearNamedBufferSubData(divisionRetryBuffer[i], GL_R32UI, 0, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+
+    divisionWheelCountShader->use();
+    divisionWheelCountShader->setFloat("u_originShift", originShift);
+    divisionWheelCountShader->setFloat("u_slotWidth", divisionSlotWidth);
+    divisionWheelCountShader->setInt("u_epochSlots", divisionEpochSlots);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, modeBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, getCellColdReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, divisionSlotCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, divisionCellSlotBuffer);
+
+    dispatchIndirect(divisionWheelCountShader, DISPATCH_CELLS_256);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    divisionWheelScanShader->use();
+    divisionWheelScanShader->setInt("u_epochSlots", divisionEpochSlots);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, divisionSlotCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, divisionSlotOffsetBuffer);
+
+    divisionWheelScanShader->dispatch(1, 1, 1);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    divisionWheelScatterShader->use();
+    divisionWheelScatterShader->setInt("u_epochSlots", divisionEpochSlots);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, divisionCellSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, divisionSlotOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, divisionWheelBuffer);
+
+    dispatchIndirect(divisionWheelScatterShader, DISPATCH_CELLS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+}
+
+void CellManager::remapDivisionWheel()
+{
+    // A wheel that is rebuilt this tick anyway is left alone
+    if (divisionScheduleDirty)
+        return;
+    TimerGPU timer("Division Wheel Remap");
+
+    divisionWheelRemapShader->use();
+    divisionWheelRemapShader->setInt("u_firstSlot", nextDivisionSlot);
+    divisionWheelRemapShader->setInt("u_epochSlots", divisionEpochSlots);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellRemapBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, divisionSlotOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, divisionWheelBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, getDivisionRetryReadBuffer());
+
+    // Both lists only hold live cells, so the cell count covers them
+    dispatchIndirect(divisionWheelRemapShader, DISPATCH_CELLS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+int CellManager::getDivisionSlot(float divisionClock) const
+{
+    // Slot s holds the splits in ((s - 1) * width, s * width]; slot 0 the ones already due at the origin
+    if (divisionClock <= 0.0f)
+        return 0;
+    float slot = std::ceil(divisionClock / divisionSlotWidth);
+    return static_cast<int>(std::min(slot, static_cast<float>(divisionEpochSlots)));
+}
+
+void CellManager::cleanupDivisionSchedule()
+{
+    GLuint* buffers[] = { &divisionSlotCountBuffer, &divisionSlotOffsetBuffer, &divisionCellSlotBuffer,
+        &divisionWheelBuffer, &divisionStateBuffer, &divisionRetryBuffer[0], &divisionRetryBuffer[1], &divisionSplitBuffer,
+        &divisionWordBuffer, &divisionWordSummaryBuffer, &divisionWordListBuffer, &divisionAdhesionNeedBuffer };
+    for (GLuint* buffer : buffers)
+    {
+        if (*buffer != 0)
+        {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    divisionScheduleDirty = true;
+}
@@ -0,0 +1,239 @@
+#include "genome_io.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static void writeQuat(std::ostream& out, const glm::quat& q)
+{
+    out << q.w << ' ' << q.x << ' ' << q.y << ' ' << q.z;
+}
+
+static bool readQuat(std::istream& in, glm::quat& q)
+{
+    float w, x, y, z;
+    if (!(in >> w >> x >> y >> z)) return false;
+    q = glm::quat(w, x, y, z);
+    return true;
+}
+
+static void writeChild(std::ostream& out, const char* key, const ChildSettings& child)
+{
+    out << key << ' ' << child.modeNumber << ' ';
+    writeQuat(out, child.orientation);
+    out << ' ' << (child.keepAdhesion ? 1 : 0) << '\n';
+}
+
+static bool readChild(std::istream& in, ChildSettings& child)
+{
+    int keep = 0;
+    if (!(in >> child.modeNumber)) return false;
+    if (!readQuat(in, child.orientation)) return false;
+    if (in >> keep) child.keepAdhesion = keep != 0;
+    return true;
+}
+
+// Rest of the line after the key, without the separating whitespace
+static std::string readRemainder(std::istream& in)
+{
+    std::string rest;
+    std::getline(in >> std::ws, rest);
+    return rest;
+}
+
+// ============================================================================
+// SAVE
+// ============================================================================
+
+bool saveGenomeToFile(const GenomeData& genome, const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Failed to open genome file for writing: " << path << "\n";
+        return false;
+    }
+
+    // Enough digits to round-trip every float exactly
+    out << std::setprecision(9);
+    out << "genome " << genome.name << '\n';
+    out << "initialMode " << genome.initialMode << '\n';
+    out << "initialOrientation ";
+    writeQuat(out, genome.initialOrientation);
+    out << '\n';
+
+    for (const ModeSettings& mode : genome.modes)
+    {
+        const AdhesionSettings& a = mode.adhesionSettings;
+        out << "\nmode\n";
+        out << "name " << mode.name << '\n';
+        out << "color " << mode.color.r << ' ' << mode.color.g << ' ' << mode.color.b << '\n';
+        out << "parentMakeAdhesion " << (mode.parentMakeAdhesion ? 1 : 0) << '\n';
+        out << "splitMass " << mode.splitMass << '\n';
+        out << "splitInterval " << mode.splitInterval << '\n';
+        out << "lifespan " << mode.lifespan << '\n';
+        out << "parentSplitDirection " << mode.parentSplitDirection.x << ' ' << mode.parentSplitDirection.y << '\n';
+        writeChild(out, "childA", mode.childA);
+        writeChild(out, "childB", mode.childB);
+        out << "adhesion " << (a.canBreak ? 1 : 0) << ' ' << a.breakForce << ' ' << a.restLength << ' '
+            << a.linearSpringStiffness << ' ' << a.linearSpringDamping << ' '
+            << a.orientationSpringStiffness << ' ' << a.orientationSpringDamping << ' '
+            << a.maxAngularDeviation << '\n';
+        out << "end\n";
+    }
+
+    return static_cast<bool>(out);
+}
+
+// ============================================================================
+// LOAD
+// ============================================================================
+
+bool loadGenomeFromFile(GenomeData& genome, const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Failed to open genome file: " << path << "\n";
+        return false;
+    }
+
+    GenomeData loaded;
+    loaded.modes.clear();
+    ModeSettings* mode = nullptr;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key) || key[0] == '#') continue;
+
+        bool ok = true;
+        if (key == "mode")
+        {
+            loaded.modes.emplace_back();
+            mode = &loaded.modes.back();
+        }
+        else if (key == "end")
+        {
+            mode = nullptr;
+        }
+        else if (!mode)
+        {
+            if (key == "genome") loaded.name = readRemainder(fields);
+            else if (key == "initialMode") ok = static_cast<bool>(fields >> loaded.initialMode);
+            else if (key == "initialOrientation") ok = readQuat(fields, loaded.initialOrientation);
+        }
+        else
+        {
+            AdhesionSettings& a = mode->adhesionSettings;
+            int flag = 0;
+            if (key == "name") mode->name = readRemainder(fields);
+            else if (key == "color") ok = static_cast<bool>(fields >> mode->color.r >> mode->color.g >> mode->color.b);
+            else if (key == "parentMakeAdhesion") { ok = static_cast<bool>(fields >> flag); mode->parentMakeAdhesion = flag != 0; }
+            else if (key == "splitMass") ok = static_cast<bool>(fields >> mode->splitMass);
+            else if (key == "splitInterval") ok = static_cast<bool>(fields >> mode->splitInterval);
+            else if (key == "lifespan") ok = static_cast<bool>(fields >> mode->lifespan);
+            else if (key == "parentSplitDirection") ok = static_cast<bool>(fields >> mode->parentSplitDirection.x >> mode->parentSplitDirection.y);
+            else if (key == "childA") ok = readChild(fields, mode->childA);
+            else if (key == "childB") ok = readChild(fields, mode->childB);
+            else if (key == "adhesion")
+            {
+                ok = static_cast<bool>(fields >> flag >> a.breakForce >> a.restLength
+                    >> a.linearSpringStiffness >> a.linearSpringDamping
+                    >> a.orientationSpringStiffness >> a.orientationSpringDamping
+                    >> a.maxAngularDeviation);
+                a.canBreak = flag != 0;
+            }
+        }
+
+        if (!ok)
+        {
+            std::cerr << "Malformed genome line " << lineNumber << " in " << path << ": " << line << "\n";
+            return false;
+        }
+    }
+
+    // Reject genomes that would index outside the mode buffer on the GPU
+    int modeCount = static_cast<int>(loaded.modes.size());
+    if (modeCount == 0)
+    {
+        std::cerr << "Genome file has no modes: " << path << "\n";
+        return false;
+    }
+    if (loaded.initialMode < 0 || loaded.initialMode >= modeCount)
+    {
+        std::cerr << "Genome initial mode " << loaded.initialMode << " out of range in " << path << "\n";
+        return false;
+    }
+    for (const ModeSettings& m : loaded.modes)
+    {
+        if (m.childA.modeNumber < 0 || m.childA.modeNumber >= modeCount ||
+            m.childB.modeNumber < 0 || m.childB.modeNumber >= modeCount)
+        {
+            std::cerr << "Mode '" << m.name << "' references a child mode out of range in " << path << "\n";
+            return false;
+        }
+    }
+
+    genome = std::move(loaded);
+    return true;
+}
+
+// ============================================================================
+// GPU MODES
+// ============================================================================
+
+static glm::vec3 pitchYawToVec3(float pitch, float yaw)
+{
+    return glm::vec3(
+        cos(pitch) * sin(yaw),
+        sin(pitch),
+        cos(pitch) * cos(yaw)
+    );
+}
+
+std::vector<GPUMode> buildGPUModes(const GenomeData& genome, int genomeOffset)
+{
+    std::vector<GPUMode> gpuModes;
+    gpuModes.reserve(genome.modes.size());
+
+    for (const ModeSettings& mode : genome.modes)
+    {
+        GPUMode gmode{};
+        gmode.color = glm::vec4(mode.color, 0.0);
+        gmode.splitInterval = mode.splitInterval;
+        gmode.lifespan = mode.lifespan;
+        gmode.genomeOffset = genomeOffset;
+
+        // Convert from pitch and yaw to padded vec4
+        gmode.splitDirection = glm::vec4(pitchYawToVec3(
+            glm::radians(mode.parentSplitDirection.x), glm::radians(mode.parentSplitDirection.y)), 0.);
+
+        // Store child mode indices
+        gmode.childModes = glm::ivec2(mode.childA.modeNumber, mode.childB.modeNumber);
+
+        // Directly store quaternions (no conversion)
+        gmode.orientationA = mode.childA.orientation;
+        gmode.orientationB = mode.childB.orientation;
+
+        // Store adhesionSettings flag
+        gmode.parentMakeAdhesion = mode.parentMakeAdhesion;
+        gmode.childAKeepAdhesion = mode.childA.keepAdhesion ? 1 : 0;
+        gmode.childBKeepAdhesion = mode.childB.keepAdhesion ? 1 : 0;
+
+        // Store adhesionSettings settings
+        gmode.adhesionSettings = mode.adhesionSettings;
+
+        gpuModes.push_back(gmode);
+    }
+    return gpuModes;
+}
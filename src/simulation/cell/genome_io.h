@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "common_structs.h"
+
+// Plain-text genome files
+// One "key value..." pair per line; each mode starts with a "mode" line and ends with "end".
+// Unknown keys are ignored so older files keep loading when new settings are added.
+bool saveGenomeToFile(const GenomeData& genome, const std::string& path);
+bool loadGenomeFromFile(GenomeData& genome, const std::string& path);
+
+// Flattens a genome into the mode array that the simulation passes look up by cell.modeIndex
+std::vector<GPUMode> buildGPUModes(const GenomeData& genome, int genomeOffset = 0);
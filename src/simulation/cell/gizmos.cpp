@@ -58,15 +58,16 @@ void CellManager::updateGizmoData()
     gizmoExtractShader->use();
     
     // Bind cell data as input
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     // Bind gizmo buffer as output
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gizmoBuffer);
     // Bind cell count buffer
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
+    // Bind cell orientations as input
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, getCellColdReadBuffer());
     
     // Dispatch compute shader
-    GLuint numGroups = (totalCellCount + 63) / 64;
-    gizmoExtractShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(gizmoExtractShader, DISPATCH_CELLS_64);
     
     // Use targeted barrier for buffer copy
     addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
@@ -179,17 +180,18 @@ void CellManager::updateRingGizmoData()
     ringGizmoExtractShader->use();
     
     // Bind cell data as input
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     // Bind mode data as input
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, modeBuffer);
     // Bind ring gizmo buffer as output
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, ringGizmoBuffer);
     // Bind cell count buffer
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer);
+    // Bind cell orientations and modes as input
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, getCellColdReadBuffer());
     
     // Dispatch compute shader
-    GLuint numGroups = (totalCellCount + 63) / 64;
-    ringGizmoExtractShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(ringGizmoExtractShader, DISPATCH_CELLS_64);
     
     // Use targeted barrier for buffer copy
     addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
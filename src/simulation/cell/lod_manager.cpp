@@ -95,7 +95,7 @@ void CellManager::runLODCompute(const Camera& camera)
     lodComputeShader->setFloat("u_lodDistances[3]", lodDistances[3]);
     
     // Bind buffers
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, modeBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, lodInstanceBuffers[0]); // LOD 0
@@ -103,10 +103,10 @@ void CellManager::runLODCompute(const Camera& camera)
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, lodInstanceBuffers[2]); // LOD 2
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, lodInstanceBuffers[3]); // LOD 3
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, lodCountBuffer);        // LOD counts
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, getCellColdReadBuffer()); // Mode and orientation
     
     // Dispatch compute shader
-    GLuint numGroups = (totalCellCount + 63) / 64;
-    lodComputeShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(lodComputeShader, DISPATCH_CELLS_64);
     
     addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
     
@@ -0,0 +1,187 @@
+#include "cell_manager.h"
+#include "../../core/config.h"
+#include <algorithm>
+#include <cstring>
+#include "../../utils/timer.h"
+
+// Verlet neighbour lists
+// Every cell lists the cells within contact distance plus neighborListSkin, found through the spatial grid
+// (neighbor_list_build.comp). As long as no cell has moved more than half the skin since the build, no pair
+// that isn't on the lists can have come into contact, so physics collides against the lists and the grid
+// isn't rebuilt at all. At physicsTimeStep = 0.01 cells move very little per tick, so the grid, the lists
+// and the 27 grid cell walk only run every few ticks.
+//
+// The displacement check runs on the GPU every tick; its result reaches the CPU through a persistently
+// mapped copy a tick or two later, which the check covers by extrapolating every cell's velocity
+// (NEIGHBOR_LIST_LEAD_TICKS). Readbacks are tagged with the build generation, so one from before the last
+// build is never mistaken for the current state. Anything that adds or renumbers cells invalidates the
+// lists: new cells (the count changes), the Morton reorder and a reset.
+
+bool CellManager::neighborListsNeedRebuild()
+{
+    if (neighborListCellCount == 0 || neighborListCellCount != totalCellCount)
+        return true;
+    if (++ticksSinceNeighborListBuild >= neighborListMaxAge)
+        return true;
+
+    // Older readbacks belong to previous lists
+    if (neighborListStatePtr == nullptr || neighborListStatePtr[0] != neighborListGeneration)
+        return false;
+
+    if (neighborListStatePtr[2] != 0)
+    {
+        // Some cells got an empty list; make room for all of them this time
+        neighborListCapacity *= 2;
+        return true;
+    }
+
+    float maxDisplacement = 0.0f;
+    std::memcpy(&maxDisplacement, &neighborListStatePtr[1], sizeof(float));
+    return maxDisplacement > neighborListSkin * 0.5f;
+}
+
+void CellManager::buildNeighborLists()
+{
+    TimerGPU timer("Neighbor List Build");
+
+    if (neighborCountBuffer == 0)
+    {
+        glCreateBuffers(1, &neighborCountBuffer);
+        glNamedBufferData(neighborCountBuffer, cellLimit * sizeof(GLuint), nullptr, GL_STREAM_COPY);
+        glCreateBuffers(1, &neighborOffsetBuffer);
+        glNamedBufferData(neighborOffsetBuffer, (cellLimit + 1) * sizeof(GLuint), nullptr, GL_STREAM_COPY);
+        glCreateBuffers(1, &neighborReferenceBuffer);
+        glNamedBufferData(neighborReferenceBuffer, cellLimit * sizeof(glm::vec4), nullptr, GL_STREAM_COPY);
+
+        glCreateBuffers(1, &neighborListStateBuffer);
+        glNamedBufferStorage(neighborListStateBuffer, 4 * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+        glCreateBuffers(1, &stagingNeighborListStateBuffer);
+        glNamedBufferStorage(stagingNeighborListStateBuffer, 4 * sizeof(GLuint), nullptr,
+            GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_DYNAMIC_STORAGE_BIT);
+        neighborListStatePtr = static_cast<GLuint*>(glMapNamedBufferRange(stagingNeighborListStateBuffer, 0, 4 * sizeof(GLuint),
+            GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+
+        neighborListCapacity = cellLimit * config::NEIGHBOR_LIST_INITIAL_CAPACITY_PER_CELL;
+    }
+
+    // Grown after an overflow (never past what a GLuint offset can address)
+    neighborListCapacity = std::min(neighborListCapacity, 1 << 30);
+    if (allocatedNeighborListCapacity != neighborListCapacity)
+    {
+        if (neighborIndexBuffer != 0)
+        {
+            glDeleteBuffers(1, &neighborIndexBuffer);
+        }
+        glCreateBuffers(1, &neighborIndexBuffer);
+        glNamedBufferData(neighborIndexBuffer, static_cast<GLsizeiptr>(neighborListCapacity) * sizeof(GLuint), nullptr, GL_STREAM_COPY);
+        allocatedNeighborListCapacity = neighborListCapacity;
+    }
+
+    // New generation: displacement, overflow flag and allocation cursor start over
+    neighborListGeneration++;
+    GLuint state[4] = { neighborListGeneration, 0, 0, 0 };
+    glNamedBufferSubData(neighborListStateBuffer, 0, sizeof(state), state);
+    glClearNamedBufferSubData(neighborOffsetBuffer, GL_R32UI, 0, sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    neighborListBuildShader->use();
+    neighborListBuildShader->setInt("u_gridResolution", config::GRID_RESOLUTION);
+    neighborListBuildShader->setFloat("u_gridCellSize", config::GRID_CELL_SIZE);
+    neighborListBuildShader->setFloat("u_worldSize", config::WORLD_SIZE);
+    neighborListBuildShader->setInt("u_gridHashSize", useHashedGrid ? gridHashBucketCount : 0);
+    neighborListBuildShader->setInt("u_gridLevels", getGridLevelCount());
+    neighborListBuildShader->setFloat("u_skin", neighborListSkin);
+    neighborListBuildShader->setInt("u_listCellCount", totalCellCount);
+    neighborListBuildShader->setInt("u_neighborCapacity", neighborListCapacity);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gridParamsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, neighborCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, neighborOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, neighborIndexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, neighborReferenceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, neighborListStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, gpuCellCountBuffer);
+
+    // The lists cover the cells the grid was built from, so both passes share its (GPU-sized) dispatch
+
+    // Count and reserve every cell's run
+    neighborListBuildShader->setInt("u_fillPass", 0);
+    dispatchIndirect(neighborListBuildShader, DISPATCH_CELLS_256);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Fill the runs
+    neighborListBuildShader->setInt("u_fillPass", 1);
+    dispatchIndirect(neighborListBuildShader, DISPATCH_CELLS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    neighborListCellCount = totalCellCount;
+    ticksSinceNeighborListBuild = 0;
+}
+
+void CellManager::runNeighborListCheck(float deltaTime)
+{
+    TimerGPU timer("Neighbor List Check");
+
+    neighborListCheckShader->use();
+    neighborListCheckShader->setFloat("u_deltaTime", deltaTime);
+    neighborListCheckShader->setFloat("u_leadTicks", config::NEIGHBOR_LIST_LEAD_TICKS);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, neighborReferenceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, neighborListStateBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer);
+
+    dispatchIndirect(neighborListCheckShader, DISPATCH_CELLS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Hand the result to neighborListsNeedRebuild() through the mapped copy (read on a later tick)
+    addBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    flushBarriers();
+    glCopyNamedBufferSubData(neighborListStateBuffer, stagingNeighborListStateBuffer, 0, 0, 4 * sizeof(GLuint));
+}
+
+void CellManager::cleanupNeighborLists()
+{
+    // Deleting the staging buffer unmaps it
+    if (neighborCountBuffer != 0)
+    {
+        glDeleteBuffers(1, &neighborCountBuffer);
+        neighborCountBuffer = 0;
+    }
+    if (neighborOffsetBuffer != 0)
+    {
+        glDeleteBuffers(1, &neighborOffsetBuffer);
+        neighborOffsetBuffer = 0;
+    }
+    if (neighborIndexBuffer != 0)
+    {
+        glDeleteBuffers(1, &neighborIndexBuffer);
+        neighborIndexBuffer = 0;
+    }
+    if (neighborReferenceBuffer != 0)
+    {
+        glDeleteBuffers(1, &neighborReferenceBuffer);
+        neighborReferenceBuffer = 0;
+    }
+    if (neighborListStateBuffer != 0)
+    {
+        glDeleteBuffers(1, &neighborListStateBuffer);
+        neighborListStateBuffer = 0;
+    }
+    if (stagingNeighborListStateBuffer != 0)
+    {
+        glDeleteBuffers(1, &stagingNeighborListStateBuffer);
+        stagingNeighborListStateBuffer = 0;
+    }
+    neighborListStatePtr = nullptr;
+
+    allocatedNeighborListCapacity = 0;
+    neighborListCellCount = 0;
+}
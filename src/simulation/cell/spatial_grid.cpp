@@ -1,5 +1,6 @@
 #include "cell_manager.h"
 #include "../../core/config.h"
+#include <algorithm>
 #include <iostream>
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -12,67 +13,126 @@ void CellManager::initializeSpatialGrid()
 {
     // Create double buffered grid buffers to store cell indices
 
+    // One entry per cell, sorted by grid cell; a grid cell's cells are gridCells[offset, offset + count)
     glCreateBuffers(1, &gridBuffer);
     glNamedBufferData(gridBuffer,
-        config::TOTAL_GRID_CELLS * config::MAX_CELLS_PER_GRID * sizeof(GLuint),
+        cellLimit * sizeof(GLuint),
         nullptr, GL_STREAM_COPY);  // Frequently updated by GPU compute shaders
 
+    // Hashed grid table: about GRID_HASH_BUCKETS_PER_CELL buckets per cell, as a power of two so the
+    // shaders can mask the hash (and capped at what the prefix sum can scan)
+    gridHashBucketCount = 1;
+    while (gridHashBucketCount < cellLimit * config::GRID_HASH_BUCKETS_PER_CELL && gridHashBucketCount < config::MAX_GRID_KEYS)
+    {
+        gridHashBucketCount *= 2;
+    }
+
+    // Counts and offsets are keyed by (multi-level) dense grid index or hash bucket, whichever mode is active
+    const int maxGridKeys = std::max(config::TOTAL_MULTI_LEVEL_GRID_CELLS, gridHashBucketCount);
+    const int maxScanBlocks = (maxGridKeys + config::GRID_SCAN_BLOCK_SIZE - 1) / config::GRID_SCAN_BLOCK_SIZE;
+
     // Create double buffered grid count buffers to store number of cells per grid cell
     glCreateBuffers(1, &gridCountBuffer);
     glNamedBufferData(gridCountBuffer,
-        config::TOTAL_GRID_CELLS * sizeof(GLuint),
+        maxGridKeys * sizeof(GLuint),
         nullptr, GL_STREAM_COPY);  // Frequently updated by GPU compute shaders
 
     // Create double buffered grid offset buffers for prefix sum calculations
     glCreateBuffers(1, &gridOffsetBuffer);
     glNamedBufferData(gridOffsetBuffer,
-        config::TOTAL_GRID_CELLS * sizeof(GLuint),
-        nullptr, GL_STREAM_COPY);  // Frequently updated by GPU compute shaders
-
-    // Create hash buffer for sparse grid optimization
-    glCreateBuffers(1, &gridHashBuffer);
-    glNamedBufferData(gridHashBuffer,
-        config::TOTAL_GRID_CELLS * sizeof(GLuint),
+        maxGridKeys * sizeof(GLuint),
         nullptr, GL_STREAM_COPY);  // Frequently updated by GPU compute shaders
 
-    // Create active cells buffer for performance optimization
-    glCreateBuffers(1, &activeCellsBuffer);
-    glNamedBufferData(activeCellsBuffer,
-        config::TOTAL_GRID_CELLS * sizeof(GLuint),
+    // Block totals and their prefix sum for the two level grid prefix sum
+    glCreateBuffers(1, &gridBlockSumBuffer);
+    glNamedBufferData(gridBlockSumBuffer,
+        maxScanBlocks * sizeof(GLuint),
+        nullptr, GL_STREAM_COPY);
+    glCreateBuffers(1, &gridBlockOffsetBuffer);
+    glNamedBufferData(gridBlockOffsetBuffer,
+        maxScanBlocks * sizeof(GLuint),
+        nullptr, GL_STREAM_COPY);
+
+    // Grid cell and slot of every cell, written by the assign pass and consumed by the insert pass
+    glCreateBuffers(1, &cellGridSlotBuffer);
+    glNamedBufferData(cellGridSlotBuffer,
+        cellLimit * 2 * sizeof(GLuint),
+        nullptr, GL_STREAM_COPY);
+
+    // Occupied grid cell list; a grid cell needs at least one cell to be on it
+    glCreateBuffers(1, &occupiedGridCellBuffer);
+    glNamedBufferData(occupiedGridCellBuffer,
+        cellLimit * sizeof(GLuint),
         nullptr, GL_STREAM_COPY);  // Frequently updated by GPU compute shaders
+    glCreateBuffers(1, &occupiedGridCountBuffer);
+    glNamedBufferData(occupiedGridCountBuffer,
+        sizeof(GLuint),
+        nullptr, GL_STREAM_COPY);
+
+    // Largest cell radius, see runGridMaxRadius
+    glCreateBuffers(1, &gridParamsBuffer);
+    glNamedBufferData(gridParamsBuffer,
+        sizeof(GLuint),
+        nullptr, GL_STREAM_COPY);
+    glClearNamedBufferData(gridParamsBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    // The clear pass only zeroes listed grid cells, so start from an all zero grid and an empty list
+    glClearNamedBufferData(gridCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glClearNamedBufferData(occupiedGridCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
 
     std::cout << "Initialized double buffered spatial grid with " << config::TOTAL_GRID_CELLS
         << " grid cells (" << config::GRID_RESOLUTION << "^3)\n";
     std::cout << "Grid cell size: " << config::GRID_CELL_SIZE << "\n";
-    std::cout << "Max cells per grid: " << config::MAX_CELLS_PER_GRID << "\n";
+    std::cout << "Sorted cell index buffer: " << cellLimit << " entries\n";
+    std::cout << "Hashed grid buckets: " << gridHashBucketCount << "\n";
+    std::cout << "Multi-level grid: " << config::GRID_LEVEL_COUNT << " levels, "
+        << config::TOTAL_MULTI_LEVEL_GRID_CELLS << " grid cells\n";
 }
 
 void CellManager::updateSpatialGrid()
 {
-    if (totalCellCount == 0)
-        return;
+    // Every pass is sized on the GPU (dispatchArgsBuffer), so an empty world just dispatches nothing
     TimerGPU timer("Spatial Grid Update");
 
     // ============= PERFORMANCE OPTIMIZATIONS FOR 100K CELLS =============
     // 1. Increased grid resolution from 32 to 64 (262,144 grid cells)
-    // 2. Reduced max cells per grid from 64 to 32 for better memory access
-    // 3. Implemented proper parallel prefix sum with shared memory
+    // 2. Counting sort into one sorted cell index array: no per-grid-cell cap, memory scales with cells
+    // 3. Two level parallel prefix sum with shared memory
     // 4. Optimized work group sizes from 64 to 256 for better GPU utilization
     // 5. Reduced memory barriers and improved dispatch efficiency
     // 6. Added early termination in physics neighbor search
+    // 7. Only occupied grid cells are cleared and scanned: the cost follows the population, not the grid
+    // 8. Search reach (or hashed cell size) follows the largest cell instead of a fixed 4 unit cutoff
     // ====================================================================
 
-    // HIGHLY OPTIMIZED: Combined operations with minimal barriers
-    // Step 1: Clear grid counts and assign cells in parallel
+    // Step 0: Largest cell radius, read by the assign pass (hashed grid cell size) and physics (search reach)
+    runGridMaxRadius();
+
+    // Counting sort of the cells by grid cell
+    // Step 1: Clear the grid cells occupied last time, then count the cells of every grid cell (the assign
+    // pass increments the counts the clear pass zeroes, so the two can't overlap)
     runGridClear();
-    runGridAssign();
 
-    // Single barrier after clear and assign - these operations can overlap
     addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
     flushBarriers();
 
-    // Step 2: Calculate prefix sum for offsets (proper implementation now)
-    runGridPrefixSum();
+    runGridAssign(false);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Step 2: Exclusive prefix sum of the counts gives every grid cell's first entry in the sorted array.
+    // Scanning the occupied list is cheaper unless it could be as long as the grid itself. The CPU-side count
+    // may lag behind, but either scan is correct for any number of cells; this only picks the cheaper one.
+    const int gridKeyCount = getGridKeyCount();
+    if (std::min(totalCellCount, cellLimit) < gridKeyCount)
+    {
+        runGridOccupiedPrefixSum();
+    }
+    else
+    {
+        runGridPrefixSum(gridKeyCount);
+    }
 
     // Step 3: Insert cells into grid (depends on prefix sum results)
     addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
@@ -103,84 +163,243 @@ void CellManager::cleanupSpatialGrid()
         glDeleteBuffers(1, &gridOffsetBuffer);
         gridOffsetBuffer = 0;
     }
-    if (gridHashBuffer != 0)
+    if (gridBlockSumBuffer != 0)
+    {
+        glDeleteBuffers(1, &gridBlockSumBuffer);
+        gridBlockSumBuffer = 0;
+    }
+    if (gridBlockOffsetBuffer != 0)
+    {
+        glDeleteBuffers(1, &gridBlockOffsetBuffer);
+        gridBlockOffsetBuffer = 0;
+    }
+    if (cellGridSlotBuffer != 0)
+    {
+        glDeleteBuffers(1, &cellGridSlotBuffer);
+        cellGridSlotBuffer = 0;
+    }
+    if (occupiedGridCellBuffer != 0)
+    {
+        glDeleteBuffers(1, &occupiedGridCellBuffer);
+        occupiedGridCellBuffer = 0;
+    }
+    if (occupiedGridCountBuffer != 0)
     {
-        glDeleteBuffers(1, &gridHashBuffer);
-        gridHashBuffer = 0;
+        glDeleteBuffers(1, &occupiedGridCountBuffer);
+        occupiedGridCountBuffer = 0;
     }
-    if (activeCellsBuffer != 0)
+    if (gridParamsBuffer != 0)
     {
-        glDeleteBuffers(1, &activeCellsBuffer);
-        activeCellsBuffer = 0;
+        glDeleteBuffers(1, &gridParamsBuffer);
+        gridParamsBuffer = 0;
     }
 }
 
+void CellManager::runGridMaxRadius()
+{
+    TimerGPU timer("Grid Max Radius");
+
+    // 0 bits are 0.0, below every radius
+    glClearNamedBufferData(gridParamsBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    gridMaxRadiusShader->use();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpuCellCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridParamsBuffer);
+
+    // Covers the cells the grid is built from; the result is read after the barrier ahead of the assign pass
+    dispatchIndirect(gridMaxRadiusShader, DISPATCH_CELLS_256);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
 void CellManager::runGridClear()
 {
-    gridClearShader->use();
+    TimerGPU timer("Grid Clear");
 
-    gridClearShader->setInt("u_totalGridCells", config::TOTAL_GRID_CELLS);
+    gridClearShader->use();
 
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, occupiedGridCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, occupiedGridCountBuffer);
 
-    // OPTIMIZED: Use larger work groups for better GPU utilization
-    GLuint numGroups = (config::TOTAL_GRID_CELLS + 255) / 256; // Changed from 64 to 256
-    gridClearShader->dispatch(numGroups, 1, 1);
+    // Sized by the list length the last assign pass left on the GPU
+    dispatchIndirect(gridClearShader, DISPATCH_OCCUPIED_256);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Empty the list for the next assign pass (ordered after the dispatch above, which reads the length)
+    glClearNamedBufferData(occupiedGridCountBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
 }
 
-void CellManager::runGridAssign()
+void CellManager::runGridAssign(bool mortonKeys)
 {
+    TimerGPU timer("Grid Assign");
+
     gridAssignShader->use();
 
     gridAssignShader->setInt("u_gridResolution", config::GRID_RESOLUTION);
     gridAssignShader->setFloat("u_gridCellSize", config::GRID_CELL_SIZE);
     gridAssignShader->setFloat("u_worldSize", config::WORLD_SIZE);
+    gridAssignShader->setInt("u_gridHashSize", useHashedGrid ? gridHashBucketCount : 0);
+    gridAssignShader->setInt("u_gridLevels", getGridLevelCount());
+    gridAssignShader->setInt("u_mortonKeys", mortonKeys ? 1 : 0);
 
-    // Use previous buffer for spatial grid to match physics compute input
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    // Only positions and masses are needed, so bind the hot buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellHotBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridCountBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpuCellCountBuffer); // Bind GPU cell count buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, cellGridSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, occupiedGridCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, occupiedGridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, gridParamsBuffer);
 
     // OPTIMIZED: Use larger work groups for better memory coalescing
-    GLuint numGroups = (totalCellCount + 255) / 256; // Changed from 64 to 256
-    gridAssignShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(gridAssignShader, DISPATCH_CELLS_256);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // The occupied list is complete: size the passes over it (scan, and the next clear)
+    runDispatchArgs();
 }
 
-void CellManager::runGridPrefixSum()
+void CellManager::runGridPrefixSum(int gridKeyCount)
 {
-    gridPrefixSumShader->use();
+    TimerGPU timer("Grid Prefix Sum");
 
-    gridPrefixSumShader->setInt("u_totalGridCells", config::TOTAL_GRID_CELLS);
+    const int scanBlocks = (gridKeyCount + config::GRID_SCAN_BLOCK_SIZE - 1) / config::GRID_SCAN_BLOCK_SIZE;
+
+    // Level 1: scan the counts block by block, keeping every block's total
+    gridPrefixSumShader->use();
+    gridPrefixSumShader->setInt("u_count", gridKeyCount);
+    gridPrefixSumShader->setInt("u_writeBlockSums", 1);
 
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridCountBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridBlockSumBuffer);
+
+    gridPrefixSumShader->dispatch(scanBlocks, 1, 1);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Level 2: scan the block totals (they fit in a single block, see MAX_GRID_KEYS)
+    gridPrefixSumShader->setInt("u_count", scanBlocks);
+    gridPrefixSumShader->setInt("u_writeBlockSums", 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridBlockSumBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBlockOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridBlockSumBuffer); // Unused, u_writeBlockSums is 0
 
-    // OPTIMIZED: Use 256-sized work groups to match shader implementation
-    GLuint numGroups = (config::TOTAL_GRID_CELLS + 255) / 256; // Changed from 64 to 256
-    gridPrefixSumShader->dispatch(numGroups, 1, 1);
+    gridPrefixSumShader->dispatch(1, 1, 1);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Level 3: add the scanned block totals to the per-block offsets
+    gridPrefixAddShader->use();
+    gridPrefixAddShader->setInt("u_totalGridCells", gridKeyCount);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBlockOffsetBuffer);
+
+    GLuint numGroups = (gridKeyCount + 255) / 256;
+    gridPrefixAddShader->dispatch(numGroups, 1, 1);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void CellManager::runGridOccupiedPrefixSum()
+{
+    TimerGPU timer("Grid Prefix Sum");
+
+    // The list never holds more grid cells than there are cells or keys; only the first level knows its
+    // actual length, the block totals past it are never read
+    const int maxScanBlocks = (std::min(cellLimit, getGridKeyCount()) + config::GRID_SCAN_BLOCK_SIZE - 1) / config::GRID_SCAN_BLOCK_SIZE;
+
+    // Level 1: scan the counts of the listed grid cells block by block, keeping every block's total
+    gridOccupiedScanShader->use();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, occupiedGridCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, occupiedGridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gridBlockSumBuffer);
+
+    dispatchIndirect(gridOccupiedScanShader, DISPATCH_OCCUPIED_BLOCKS);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Level 2: scan the block totals, exactly like the full grid prefix sum
+    gridPrefixSumShader->use();
+    gridPrefixSumShader->setInt("u_count", maxScanBlocks);
+    gridPrefixSumShader->setInt("u_writeBlockSums", 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridBlockSumBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBlockOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridBlockSumBuffer); // Unused, u_writeBlockSums is 0
+
+    gridPrefixSumShader->dispatch(1, 1, 1);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Level 3: add the scanned block totals to the offsets of the listed grid cells
+    gridOccupiedAddShader->use();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, occupiedGridCellBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, occupiedGridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gridBlockOffsetBuffer);
+
+    dispatchIndirect(gridOccupiedAddShader, DISPATCH_OCCUPIED_256);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
 void CellManager::runGridInsert()
 {
-    gridInsertShader->use();    gridInsertShader->setInt("u_gridResolution", config::GRID_RESOLUTION);
-    gridInsertShader->setFloat("u_gridCellSize", config::GRID_CELL_SIZE);
-    gridInsertShader->setFloat("u_worldSize", config::WORLD_SIZE);
-    gridInsertShader->setInt("u_maxCellsPerGrid", config::MAX_CELLS_PER_GRID); // Use previous buffer for spatial grid to match physics compute input
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, getCellReadBuffer());
+    TimerGPU timer("Grid Insert");
+
+    gridInsertShader->use();
+
+    // Slots were claimed by the assign pass, so no positions are needed
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellGridSlotBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBuffer);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridOffsetBuffer);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gridCountBuffer);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gpuCellCountBuffer); // Bind GPU cell count buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer); // Bind GPU cell count buffer
 
     // OPTIMIZED: Use larger work groups for better memory coalescing
-    GLuint numGroups = (totalCellCount + 255) / 256; // Changed from 64 to 256
-    gridInsertShader->dispatch(numGroups, 1, 1);
+    dispatchIndirect(gridInsertShader, DISPATCH_CELLS_256);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    // Slots were claimed in thread order; rank every cell by index among the entries of its grid cell and
+    // insert again at the ranks, so that physics and the Morton reorder don't depend on it
+    gridRankShader->use();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellGridSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridCountBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, gpuCellCountBuffer);
+
+    dispatchIndirect(gridRankShader, DISPATCH_CELLS_256);
+
+    addBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    flushBarriers();
+
+    gridInsertShader->use();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cellGridSlotBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gridBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gridOffsetBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gpuCellCountBuffer);
+
+    dispatchIndirect(gridInsertShader, DISPATCH_CELLS_256);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "ui_manager.h"
 #include "../simulation/cell/cell_manager.h"
+#include "../simulation/cell/genome_io.h"
 #include "../core/config.h"
 #include "imgui.h"
 #include <algorithm>
@@ -47,9 +48,11 @@ void UIManager::renderGenomeEditor(CellManager& cellManager, SceneManager& scene
     ImGui::PopItemWidth();
 
     ImGui::SameLine();
+    // Genomes are stored as "<genome name>.genome" next to the executable
+    static bool genomeFileOk = false;
     if (ImGui::Button("Save Genome"))
     {
-        // TODO: Implement genome saving functionality
+        genomeFileOk = saveGenomeToFile(currentGenome, currentGenome.name + ".genome");
         ImGui::OpenPopup("Save Confirmation");
     }
     addTooltip("Save the current genome configuration to file");
@@ -57,7 +60,12 @@ void UIManager::renderGenomeEditor(CellManager& cellManager, SceneManager& scene
     ImGui::SameLine();
     if (ImGui::Button("Load Genome"))
     {
-        // TODO: Implement genome loading functionality
+        genomeFileOk = loadGenomeFromFile(currentGenome, currentGenome.name + ".genome");
+        if (genomeFileOk)
+        {
+            selectedModeIndex = 0;
+            genomeChanged = true;
+        }
         ImGui::OpenPopup("Load Confirmation");
     }
     addTooltip("Load a previously saved genome configuration");
@@ -65,8 +73,10 @@ void UIManager::renderGenomeEditor(CellManager& cellManager, SceneManager& scene
     // Save confirmation popup
     if (ImGui::BeginPopupModal("Save Confirmation", NULL, ImGuiWindowFlags_AlwaysAutoResize))
     {
-        ImGui::Text("Genome '%s' saved successfully!", currentGenome.name.c_str());
-        ImGui::Text("(Save functionality not yet implemented)");
+        if (genomeFileOk)
+            ImGui::Text("Genome '%s' saved successfully!", currentGenome.name.c_str());
+        else
+            ImGui::Text("Failed to save '%s.genome'", currentGenome.name.c_str());
         if (ImGui::Button("OK"))
             ImGui::CloseCurrentPopup();
         ImGui::EndPopup();
@@ -75,7 +85,10 @@ void UIManager::renderGenomeEditor(CellManager& cellManager, SceneManager& scene
     // Load confirmation popup
     if (ImGui::BeginPopupModal("Load Confirmation", NULL, ImGuiWindowFlags_AlwaysAutoResize))
     {
-        ImGui::Text("Load genome functionality not yet implemented.");
+        if (genomeFileOk)
+            ImGui::Text("Genome '%s' loaded successfully!", currentGenome.name.c_str());
+        else
+            ImGui::Text("Failed to load '%s.genome'", currentGenome.name.c_str());
         if (ImGui::Button("OK"))
             ImGui::CloseCurrentPopup();
         ImGui::EndPopup();
@@ -263,20 +276,9 @@ void UIManager::renderGenomeEditor(CellManager& cellManager, SceneManager& scene
             bool wasPaused = sceneManager.isPaused();
             sceneManager.setPaused(true);
             
-            // Use a coarser time step for scrubbing to make it more responsive
-            float scrubTimeStep = config::scrubTimeStep;
-            float timeRemaining = currentTime;
-            int maxSteps = (int)(currentTime / scrubTimeStep) + 1;
-            
-            for (int i = 0; i < maxSteps && timeRemaining > 0.0f; ++i)
-            {
-                float stepTime = (timeRemaining > scrubTimeStep) ? scrubTimeStep : timeRemaining;
-                cellManager.updateCells(stepTime);
-                timeRemaining -= stepTime;
-                
-                // Update simulation time manually during fast-forward
-                sceneManager.setPreviewSimulationTime(currentTime - timeRemaining);
-            }
+            // Use a coarser time step for scrubbing to make it more responsive (batched, see stepMany)
+            cellManager.advanceTime(currentTime, config::scrubTimeStep);
+            sceneManager.setPreviewSimulationTime(currentTime);
             
             // Restore original pause state after fast-forward
             sceneManager.setPaused(wasPaused);
@@ -532,7 +534,10 @@ void UIManager::drawParentSettings(ModeSettings &mode)
     addTooltip("The mass threshold at which the cell will split into two child cells");
     
     drawSliderWithInput("Split Interval", &mode.splitInterval, 1.0f, 30.0f, "%.1f");
-    addTooltip("Time interval (in seconds) between cell splits");    // Add divider before Parent Split Angle
+    addTooltip("Time interval (in seconds) between cell splits");
+
+    drawSliderWithInput("Lifespan", &mode.lifespan, 0.0f, 60.0f, "%.1f");
+    addTooltip("Age (in seconds) at which the cell dies unless it splits first (0 = never)");    // Add divider before Parent Split Angle
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Spacing();
@@ -1,6 +1,7 @@
 #include "ui_manager.h"
 #include "../simulation/cell/cell_manager.h"
 #include "../core/config.h"
+#include "../utils/job_system.h"
 #include "imgui.h"
 #include <algorithm>
 #include <string>
@@ -39,16 +40,9 @@ void UIManager::initializeKeyframes(CellManager& cellManager)
         float targetTime = i * timeInterval;
         float currentSimTime = (i - 1) * timeInterval;
         
-        // Simulate from previous keyframe to current keyframe
+        // Simulate from previous keyframe to current keyframe, in one batch (a single GPU sync per interval)
         float timeToSimulate = targetTime - currentSimTime;
-        float scrubTimeStep = config::scrubTimeStep;
-        
-        while (timeToSimulate > 0.0f)
-        {
-            float stepTime = (timeToSimulate > scrubTimeStep) ? scrubTimeStep : timeToSimulate;
-            cellManager.updateCells(stepTime);
-            timeToSimulate -= stepTime;
-        }
+        cellManager.advanceTime(timeToSimulate, config::scrubTimeStep);
         
         // Capture keyframe
         captureKeyframe(cellManager, targetTime, i);
@@ -145,8 +139,8 @@ void UIManager::restoreFromKeyframe(CellManager& cellManager, int keyframeIndex)
         cellManager.restoreAdhesionConnections(keyframes[keyframeIndex].adhesionConnections, keyframes[keyframeIndex].adhesionCount);
     }
     
-    // Update CPU-side counts to match GPU state
-    cellManager.updateCounts();
+    // Update CPU-side counts to match GPU state (a one-off, so waiting for them is fine)
+    cellManager.waitForCounts();
     
     // Verify restoration by checking first cell position and age
     if (keyframes[keyframeIndex].cellCount > 0) {
@@ -203,13 +197,15 @@ void UIManager::captureKeyframe(CellManager& cellManager, float time, int keyfra
     cellManager.syncCellPositionsFromGPU();
     
     // Copy cell states
-    keyframe.cellStates.clear();
-    keyframe.cellStates.reserve(keyframe.cellCount);
+    keyframe.cellStates.resize(keyframe.cellCount);
     
-    for (int i = 0; i < keyframe.cellCount; i++)
+    JobSystem::get().parallelFor(keyframe.cellCount, [&](int begin, int end)
     {
-        keyframe.cellStates.push_back(cellManager.getCellData(i));
-    }
+        for (int i = begin; i < end; i++)
+        {
+            keyframe.cellStates[i] = cellManager.getCellData(i);
+        }
+    }, 4096);
     
     // Capture adhesion connections
     keyframe.adhesionConnections = cellManager.getAdhesionConnections();
@@ -9,6 +9,7 @@
 // Forward declarations
 struct CellManager; // Forward declaration to avoid circular dependency
 class SceneManager; // Forward declaration for scene management
+class SimulationThread; // Main scene simulation on its own thread
 struct ComputeCell; // Forward declaration for keyframe system
 
 enum class ToolType : std::uint8_t
@@ -103,6 +104,10 @@ public:
     // Distance-based culling and fading toggle
     bool enableDistanceCulling = true;   // Toggle for distance-based culling and fading
 
+    // Main scene simulated on its own thread (CPU backend) while this is running; owned by main()
+    SimulationThread* mainSimulationThread = nullptr;
+    void resetMainSimulation(CellManager& mainCellManager);
+
 private:    // Helper to get window flags based on lock state
     int getWindowFlags(int baseFlags = 0) const;
     
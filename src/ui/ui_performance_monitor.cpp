@@ -185,8 +185,40 @@ void UIManager::renderPerformanceMonitor(CellManager &cellManager, PerformanceMo
     ImGui::Text("Total Adhesion Connections: %i / %i", cellManager.totalAdhesionCount, config::MAX_ADHESIONS);
     ImGui::Text("Live Adhesion Connections: %i / %i", cellManager.liveAdhesionCount, cellManager.totalAdhesionCount);
     ImGui::Text("Pending Cells: %i", cellManager.pendingCellCount);
+    ImGui::Text("Count Readback Age: %i ticks", cellManager.getCountsAge());
     ImGui::Text("Triangles: %i", cellManager.getTotalTriangleCount());
     ImGui::Text("Vertices: %i", cellManager.getTotalVertexCount());
+    ImGui::Checkbox("Fused Physics + Integration", &cellManager.useFusedPhysics);
+    ImGui::Checkbox("Hashed Sparse Grid (no world walls)", &cellManager.useHashedGrid);
+    ImGui::Checkbox("Multi-Level Grid (dense grid only)", &cellManager.useMultiLevelGrid);
+    ImGui::SliderInt("Morton Reorder Interval", &cellManager.mortonReorderInterval, 0, 1000, "%d ticks (0 = off)");
+    ImGui::SliderInt("Dead Cell Compaction Interval", &cellManager.cellCompactionInterval, 0, 1000, "%d ticks (0 = with reorder)");
+    ImGui::Checkbox("Verlet Neighbour Lists", &cellManager.useNeighborLists);
+    if (cellManager.useNeighborLists)
+    {
+        ImGui::SliderFloat("Neighbour List Skin", &cellManager.neighborListSkin, 0.05f, 2.0f, "%.2f");
+        ImGui::SliderInt("Neighbour List Max Age", &cellManager.neighborListMaxAge, 1, 100, "%d ticks");
+    }
+    ImGui::BeginDisabled(!cellManager.sleepingAvailable);
+    ImGui::Checkbox("Sleeping Cells", &cellManager.useSleeping);
+    ImGui::EndDisabled();
+    if (cellManager.useSleeping)
+    {
+        ImGui::Text("Awake Cells: %i / %i", cellManager.activeCellCount, cellManager.totalCellCount);
+    }
+    int integrator = static_cast<int>(cellManager.integrator);
+    if (ImGui::Combo("Integrator", &integrator, config::INTEGRATOR_NAMES, IM_ARRAYSIZE(config::INTEGRATOR_NAMES)))
+    {
+        cellManager.integrator = static_cast<config::Integrator>(integrator);
+    }
+    ImGui::Checkbox("Adaptive Time Step", &cellManager.useAdaptiveTimeStep);
+    if (cellManager.useAdaptiveTimeStep)
+    {
+        const TimestepStats& stats = cellManager.getTimestepStats();
+        ImGui::Text("Time Step: %.4f s", cellManager.getLastTimeStep());
+        ImGui::Text("Max Speed: %.3f  Max Acceleration: %.3f", stats.maxSpeed, stats.maxAcceleration);
+        ImGui::Text("Max Overlap: %.1f%%", stats.maxOverlap * 100.0f);
+    }
 
     // Memory estimate
     float memoryMB = (cellCount * sizeof(ComputeCell)) / (1024.0f * 1024.0f);
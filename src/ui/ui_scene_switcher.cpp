@@ -11,6 +11,7 @@
 
 #include "../audio/audio_engine.h"
 #include "../scene/scene_manager.h"
+#include "../simulation/backend/simulation_thread.h"
 
 // Ensure std::min and std::max are available
 #ifdef min
@@ -20,6 +21,28 @@
 #undef max
 #endif
 
+void UIManager::resetMainSimulation(CellManager& mainCellManager)
+{
+    ComputeCell newCell{};
+    newCell.modeIndex = currentGenome.initialMode;
+
+    mainCellManager.resetSimulation();
+    mainCellManager.addGenomeToBuffer(currentGenome);
+
+    if (mainSimulationThread && mainSimulationThread->isRunning())
+    {
+        // The thread's snapshots replace the cells; the genome above is still needed to draw them
+        mainSimulationThread->reset(currentGenome, newCell);
+        return;
+    }
+
+    mainCellManager.addCellToStagingBuffer(newCell);
+    mainCellManager.addStagedCellsToQueueBuffer(); // Force immediate GPU buffer sync
+
+    // Advance simulation by one frame after reset
+    mainCellManager.updateCells(config::physicsTimeStep);
+}
+
 void UIManager::renderSceneSwitcher(SceneManager& sceneManager, CellManager& previewCellManager, CellManager& mainCellManager)
 {
     // Set window position on first use - top center
@@ -66,17 +89,36 @@ void UIManager::renderSceneSwitcher(SceneManager& sceneManager, CellManager& pre
             ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.7f, 0.3f, 0.3f, 1.0f)); // Red for reset
             if (ImGui::Button("Reset Main", ImVec2(150, 30)))
             {
-                mainCellManager.resetSimulation();
-                mainCellManager.addGenomeToBuffer(currentGenome);
-                ComputeCell newCell{};
-                newCell.modeIndex = currentGenome.initialMode;
-                mainCellManager.addCellToStagingBuffer(newCell);
-                mainCellManager.addStagedCellsToQueueBuffer(); // Force immediate GPU buffer sync
-                
-                // Advance simulation by one frame after reset
-                mainCellManager.updateCells(config::physicsTimeStep);
+                resetMainSimulation(mainCellManager);
             }
             ImGui::PopStyleColor();
+
+            // Simulation thread: the main scene runs on the CPU backend, apart from rendering and the UI
+            if (mainSimulationThread)
+            {
+                bool threaded = mainSimulationThread->isRunning();
+                if (ImGui::Checkbox("Simulate on Separate Thread (CPU)", &threaded))
+                {
+                    if (threaded)
+                    {
+                        mainSimulationThread->start();
+                    }
+                    else
+                    {
+                        mainSimulationThread->stop();
+                    }
+                    resetMainSimulation(mainCellManager); // Neither side can carry on from the other's state
+                }
+                if (mainSimulationThread->isRunning())
+                {
+                    bool unlimited = mainSimulationThread->isUnlimited();
+                    if (ImGui::Checkbox("Unlimited Tick Rate", &unlimited))
+                    {
+                        mainSimulationThread->setUnlimited(unlimited);
+                    }
+                    ImGui::Text("Simulation Thread: %.0f ticks/s", mainSimulationThread->getTicksPerSecond());
+                }
+            }
         }
         else if (currentScene == Scene::PreviewSimulation)
         {
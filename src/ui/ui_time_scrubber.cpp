@@ -164,21 +164,9 @@ void UIManager::renderTimeScrubber(CellManager& cellManager, SceneManager& scene
                     bool wasPaused = sceneManager.isPaused();
                     sceneManager.setPaused(true);
                     
-                    float timeRemaining = targetTime - nearestKeyframe.time;
-                    float physicsTimeStep = config::physicsTimeStep;
-                    int maxSteps = (int)(timeRemaining / physicsTimeStep) + 1;
-                    
-
-                    
-                    for (int i = 0; i < maxSteps && timeRemaining > 0.0f; ++i)
-                    {
-                        float stepTime = (timeRemaining > physicsTimeStep) ? physicsTimeStep : timeRemaining;
-                        cellManager.updateCells(stepTime);
-                        timeRemaining -= stepTime;
-                        
-                        // Update simulation time manually during fast-forward
-                        sceneManager.setPreviewSimulationTime(targetTime - timeRemaining);
-                    }
+                    // All ticks in one batch, with a single sync at the end
+                    cellManager.advanceTime(targetTime - nearestKeyframe.time, config::physicsTimeStep);
+                    sceneManager.setPreviewSimulationTime(targetTime);
                     
                     // CRITICAL FIX: Verify timing accuracy after fast-forward
                     if (nearestKeyframeIndex < keyframes.size() && keyframes[nearestKeyframeIndex].cellCount > 0) {
@@ -218,20 +206,9 @@ void UIManager::renderTimeScrubber(CellManager& cellManager, SceneManager& scene
                     // Temporarily pause to prevent normal time updates during fast-forward
                     bool wasPaused = sceneManager.isPaused();
                     sceneManager.setPaused(true);
-                      // Use a coarser time step for scrubbing to make it more responsive
-                    float scrubTimeStep = config::scrubTimeStep;
-                    float timeRemaining = targetTime;
-                    int maxSteps = (int)(targetTime / scrubTimeStep) + 1;
-                    
-                    for (int i = 0; i < maxSteps && timeRemaining > 0.0f; ++i)
-                    {
-                        float stepTime = (timeRemaining > scrubTimeStep) ? scrubTimeStep : timeRemaining;
-                        cellManager.updateCells(stepTime);
-                        timeRemaining -= stepTime;
-                        
-                        // Update simulation time manually during fast-forward
-                        sceneManager.setPreviewSimulationTime(targetTime - timeRemaining);
-                    }
+                      // Use a coarser time step for scrubbing to make it more responsive (batched, see stepMany)
+                    cellManager.advanceTime(targetTime, config::scrubTimeStep);
+                    sceneManager.setPreviewSimulationTime(targetTime);
                     
                     // Restore original pause state after fast-forward
                     sceneManager.setPaused(wasPaused);
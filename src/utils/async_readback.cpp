@@ -0,0 +1,101 @@
+#include "async_readback.h"
+#include <cstring>
+
+void AsyncReadback::init(GLsizeiptr size)
+{
+	cleanup();
+
+	slotSize = size;
+	glCreateBuffers(1, &buffer);
+	glNamedBufferStorage(buffer, slotSize * SLOT_COUNT, nullptr,
+		GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+	mapped = static_cast<const uint8_t*>(glMapNamedBufferRange(buffer, 0, slotSize * SLOT_COUNT,
+		GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+
+	latest.assign(static_cast<size_t>(slotSize), 0);
+	requestCount = 0;
+	latestRequest = 0;
+}
+
+void AsyncReadback::cleanup()
+{
+	discard();
+
+	// Deleting the buffer unmaps it
+	if (buffer != 0)
+	{
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+	mapped = nullptr;
+}
+
+bool AsyncReadback::request(GLuint sourceBuffer, GLintptr offset)
+{
+	if (buffer == 0 || slotsInFlight == SLOT_COUNT)
+	{
+		return false;
+	}
+
+	int slot = (oldestSlot + slotsInFlight) % SLOT_COUNT;
+	glCopyNamedBufferSubData(sourceBuffer, buffer, offset, slot * slotSize, slotSize);
+	fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slotRequest[slot] = ++requestCount;
+	slotsInFlight++;
+	return true;
+}
+
+bool AsyncReadback::poll()
+{
+	bool changed = false;
+
+	// Copies finish in order, so stop at the first one that hasn't
+	while (slotsInFlight > 0)
+	{
+		GLsync fence = fences[oldestSlot];
+		GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+		{
+			break;
+		}
+
+		std::memcpy(latest.data(), mapped + oldestSlot * slotSize, static_cast<size_t>(slotSize));
+		latestRequest = slotRequest[oldestSlot];
+		changed = true;
+
+		glDeleteSync(fence);
+		fences[oldestSlot] = nullptr;
+		oldestSlot = (oldestSlot + 1) % SLOT_COUNT;
+		slotsInFlight--;
+	}
+
+	return changed;
+}
+
+void AsyncReadback::wait()
+{
+	if (slotsInFlight > 0)
+	{
+		// The newest copy finishing implies the older ones have as well
+		int newestSlot = (oldestSlot + slotsInFlight - 1) % SLOT_COUNT;
+		glClientWaitSync(fences[newestSlot], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+	}
+	poll();
+}
+
+void AsyncReadback::discard()
+{
+	for (GLsync& fence : fences)
+	{
+		if (fence != nullptr)
+		{
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	oldestSlot = 0;
+	slotsInFlight = 0;
+
+	// The caller knows the current contents, so they count as read just now
+	latestRequest = requestCount;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "glad/glad.h"
+
+// Non-blocking GPU -> CPU readback of a small buffer range
+// Every request copies the range into the next slot of a persistently mapped ring and puts a fence behind
+// the copy. poll() takes whatever copies the GPU has finished by then, without waiting, so the result is
+// the newest finished copy and may be a few requests old. getAge() says how old: the number of requests
+// issued after the one the result came from. When every slot is still in flight, a request is dropped
+// rather than waiting for one to free up.
+class AsyncReadback {
+public:
+	static constexpr int SLOT_COUNT = 3;
+
+	AsyncReadback() = default;
+	~AsyncReadback() = default; // GL objects go in cleanup(), while the context still exists
+
+	AsyncReadback(const AsyncReadback&) = delete;
+	AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+	void init(GLsizeiptr size);
+	void cleanup();
+
+	// Queues a copy of [offset, offset + size) of sourceBuffer; false if the ring is full (nothing queued).
+	// Shader writes to the source need a GL_BUFFER_UPDATE_BARRIER_BIT barrier before this.
+	bool request(GLuint sourceBuffer, GLintptr offset = 0);
+	bool poll();    // Takes every finished copy; true if the result changed
+	void wait();    // Blocks until every queued copy has finished, then polls
+	void discard(); // Drops queued copies after the CPU overwrote the source (and so knows its contents)
+
+	const void* getLatest() const { return latest.data(); }
+	int getAge() const { return static_cast<int>(requestCount - latestRequest); }
+
+private:
+	GLuint buffer = 0;
+	const uint8_t* mapped = nullptr;
+	GLsizeiptr slotSize = 0;
+
+	GLsync fences[SLOT_COUNT]{};
+	uint64_t slotRequest[SLOT_COUNT]{}; // Request number of the copy in each slot
+	int oldestSlot = 0;                 // Slots in flight run from oldestSlot, in request order
+	int slotsInFlight = 0;
+
+	uint64_t requestCount = 0;
+	uint64_t latestRequest = 0;         // Request the latest result came from
+	std::vector<uint8_t> latest;
+};
@@ -0,0 +1,181 @@
+#include "job_system.h"
+#include <algorithm>
+
+// Which system (and queue) the current thread works for; unset on threads the system didn't start
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentQueueIndex = 0;
+
+JobSystem::JobSystem(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	threadCount = std::max(threadCount, 1);
+
+	queues.reserve(threadCount);
+	for (int i = 0; i < threadCount; i++)
+	{
+		queues.push_back(std::make_unique<Queue>());
+	}
+
+	workers.reserve(threadCount - 1);
+	for (int i = 1; i < threadCount; i++)
+	{
+		workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	wakeWorkers.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+JobSystem& JobSystem::get()
+{
+	static JobSystem instance;
+	return instance;
+}
+
+int JobSystem::currentQueue() const
+{
+	return currentSystem == this ? currentQueueIndex : 0;
+}
+
+void JobSystem::parallelFor(int count, const std::function<void(int, int)>& fn, int minRange)
+{
+	if (count <= 0) return;
+	minRange = std::max(minRange, 1);
+
+	// Small loops aren't worth waking the workers for
+	if (workers.empty() || count <= minRange)
+	{
+		fn(0, count);
+		return;
+	}
+
+	std::atomic<int> remaining{ count };
+	int queueIndex = currentQueue();
+	runRange(queueIndex, Range{ &fn, 0, count, minRange, &remaining });
+
+	// Ranges split off this call may still be running on other threads (or sitting in a queue);
+	// help out with whatever is queued until they are all done
+	while (remaining.load(std::memory_order_acquire) > 0)
+	{
+		Range range;
+		if (popOwn(queueIndex, range) || steal(queueIndex, range))
+		{
+			runRange(queueIndex, range);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::runRange(int queueIndex, Range range)
+{
+	while (range.end - range.begin > range.minRange)
+	{
+		// Only split when the previous half has been taken; otherwise the split is pure overhead
+		if (range.end - range.begin >= range.minRange * 2 && isEmpty(queueIndex))
+		{
+			int middle = range.begin + (range.end - range.begin) / 2;
+			Range upper = range;
+			upper.begin = middle;
+			push(queueIndex, upper);
+			range.end = middle;
+			continue;
+		}
+
+		int chunkEnd = range.begin + range.minRange;
+		(*range.fn)(range.begin, chunkEnd);
+		range.remaining->fetch_sub(chunkEnd - range.begin, std::memory_order_acq_rel);
+		range.begin = chunkEnd;
+	}
+
+	(*range.fn)(range.begin, range.end);
+	range.remaining->fetch_sub(range.end - range.begin, std::memory_order_acq_rel);
+}
+
+void JobSystem::push(int queueIndex, const Range& range)
+{
+	{
+		std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+		queues[queueIndex]->ranges.push_back(range);
+	}
+	queuedRanges.fetch_add(1, std::memory_order_release);
+
+	// Taking the sleep mutex orders this push against a worker that is about to go to sleep
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	wakeWorkers.notify_one();
+}
+
+bool JobSystem::popOwn(int queueIndex, Range& range)
+{
+	Queue& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.ranges.empty()) return false;
+
+	// Newest range first: it is the smallest and its data is most likely still in cache
+	range = queue.ranges.back();
+	queue.ranges.pop_back();
+	queuedRanges.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+bool JobSystem::steal(int queueIndex, Range& range)
+{
+	int queueCount = static_cast<int>(queues.size());
+	for (int offset = 1; offset < queueCount; offset++)
+	{
+		Queue& queue = *queues[(queueIndex + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.ranges.empty()) continue;
+
+		// Oldest range: the largest piece of work the owner hasn't started on
+		range = queue.ranges.front();
+		queue.ranges.pop_front();
+		queuedRanges.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+bool JobSystem::isEmpty(int queueIndex)
+{
+	Queue& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	return queue.ranges.empty();
+}
+
+void JobSystem::workerLoop(int queueIndex)
+{
+	currentSystem = this;
+	currentQueueIndex = queueIndex;
+
+	for (;;)
+	{
+		Range range;
+		if (popOwn(queueIndex, range) || steal(queueIndex, range))
+		{
+			runRange(queueIndex, range);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeWorkers.wait(lock, [this] { return stopping || queuedRanges.load(std::memory_order_acquire) > 0; });
+		if (stopping) return;
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing scheduler for data-parallel loops
+// Every thread owns a deque of index ranges. A thread works on the newest range of its own deque and,
+// when that runs dry, steals the oldest (largest) range from another thread's deque. Ranges are split
+// lazily: a thread only halves its current range while its own deque is empty, i.e. when the previous
+// half has already been stolen by an idle thread. Uniform loops therefore end up as a few large ranges,
+// while uneven loops (dense grid regions, ray hits clustered in one area) keep getting split until
+// every thread has something to do.
+//
+// The calling thread always takes part in the work, so a system of N threads starts N - 1 workers.
+// Any thread may call parallelFor, including code already running inside a parallelFor range.
+class JobSystem {
+public:
+	explicit JobSystem(int threadCount = 0); // 0 = one thread per hardware thread
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Process-wide instance for UI and CellManager work (one thread per hardware thread)
+	static JobSystem& get();
+
+	int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+	// Calls fn(begin, end) for disjoint ranges covering [0, count) and blocks until all of them are done.
+	// Ranges are never split below minRange items (the last one may be shorter). Ranges run concurrently,
+	// so fn must only write to its own range (or synchronise itself).
+	void parallelFor(int count, const std::function<void(int, int)>& fn, int minRange = 256);
+
+private:
+	struct Range {
+		const std::function<void(int, int)>* fn;
+		int begin;
+		int end;
+		int minRange;
+		std::atomic<int>* remaining; // Items of the parallelFor call still to be processed
+	};
+
+	struct alignas(64) Queue {
+		std::mutex mutex;
+		std::deque<Range> ranges;
+	};
+
+	void workerLoop(int queueIndex);
+	int currentQueue() const;
+
+	void push(int queueIndex, const Range& range);
+	bool popOwn(int queueIndex, Range& range);
+	bool steal(int queueIndex, Range& range);
+	bool isEmpty(int queueIndex);
+	void runRange(int queueIndex, Range range);
+
+	// Queue 0 is shared by every thread that isn't one of this system's workers
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+
+	std::atomic<int> queuedRanges{ 0 };
+	std::mutex sleepMutex;
+	std::condition_variable wakeWorkers;
+	bool stopping = false;
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+// Minimal streaming JSON writer for tool output (headless runs, benchmarks)
+// Tracks nesting so callers only deal with keys and values, commas are inserted automatically.
+class JsonWriter {
+public:
+	explicit JsonWriter(std::ostream& out) : out(out) {}
+
+	void beginObject() { prefix(); out << '{'; push(); }
+	void beginObject(const char* key) { writeKey(key); out << '{'; push(); }
+	void endObject() { pop(); out << '}'; }
+
+	void beginArray() { prefix(); out << '['; push(); }
+	void beginArray(const char* key) { writeKey(key); out << '['; push(); }
+	void endArray() { pop(); out << ']'; }
+
+	void value(const char* key, const std::string& v) { writeKey(key); writeString(v); }
+	void value(const char* key, const char* v) { writeKey(key); writeString(v); }
+	void value(const char* key, double v) { writeKey(key); writeNumber(v); }
+	void value(const char* key, long long v) { writeKey(key); out << v; }
+	void value(const char* key, int v) { writeKey(key); out << v; }
+	void value(const char* key, bool v) { writeKey(key); out << (v ? "true" : "false"); }
+
+	void value(double v) { prefix(); writeNumber(v); }
+	void value(const std::string& v) { prefix(); writeString(v); }
+
+private:
+	void writeKey(const char* key) {
+		prefix();
+		writeString(key);
+		out << ": ";
+	}
+
+	// Comma and indentation before every element except the first in its scope
+	void prefix() {
+		if (!hasElement.empty()) {
+			if (hasElement.back()) out << ',';
+			hasElement.back() = true;
+			newline();
+		}
+	}
+
+	void push() { hasElement.push_back(false); }
+
+	void pop() {
+		bool nonEmpty = hasElement.back();
+		hasElement.pop_back();
+		if (nonEmpty) newline();
+	}
+
+	void newline() {
+		out << '\n';
+		for (size_t i = 0; i < hasElement.size(); i++) out << "  ";
+	}
+
+	// JSON has no NaN/Inf, write null so the file stays parseable
+	void writeNumber(double v) {
+		if (std::isfinite(v)) out << v;
+		else out << "null";
+	}
+
+	void writeString(const std::string& s) {
+		out << '"';
+		for (char c : s) {
+			switch (c) {
+			case '"': out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\t': out << "\\t"; break;
+			default:
+				// Any other control character (e.g. the '\r' of a CRLF genome file) would make the file invalid
+				if (static_cast<unsigned char>(c) < 0x20) {
+					const char* hex = "0123456789abcdef";
+					out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+				}
+				else out << c;
+				break;
+			}
+		}
+		out << '"';
+	}
+
+	std::ostream& out;
+	std::vector<bool> hasElement;
+};
@@ -1,3 +1,9 @@
 #include "timer.h"
 
-float myMax(const float a, const float b) { return a > b ? a : b; }
\ No newline at end of file
+float myMax(const float a, const float b) { return a > b ? a : b; }
+
+double getProgramTime()
+{
+	static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
@@ -5,10 +5,14 @@
 #include "imgui.h"
 #include "glad/glad.h"
 #include <unordered_map>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <algorithm>
 
 float myMax(const float a, const float b); // Regular max isn't working for some reason??? so, I have to make my own
+double getProgramTime(); // Seconds since startup for shader animations, like glfwGetTime() but without GLFW (headless tools)
 
 struct TimerStats {
 	float lastTimeMs = 0.0f;
@@ -17,6 +21,8 @@ struct TimerStats {
 	float maxTimeMs = 0.0f;
 
 	int tickCount = 0;
+
+	std::vector<float> samples; // Every sample, only filled while TimerManager::setRecordSamples(true)
 	
 	void addSample(float timeMs) {
 		lastTimeMs = timeMs;
@@ -44,11 +50,23 @@ public:
 		return inst;
 	}
 
+	// Samples may come from the simulation thread (SimulationThread) as well as the render thread
 	void addSample(const std::string& name, float timeMs) {
-		timers[name].addSample(timeMs);
+		std::lock_guard<std::mutex> lock(mutex);
+		TimerStats& timer = timers[name];
+		timer.addSample(timeMs);
+		if (recordSamples) timer.samples.push_back(timeMs);
 	}
 
+	// Keep every individual sample (for percentiles in benchmarks); off by default, samples grow without bound
+	void setRecordSamples(bool record) { std::lock_guard<std::mutex> lock(mutex); recordSamples = record; }
+
+	// TimerGPU waits for its queries, which stalls the pipeline after every pass; batched stepping turns them off
+	void setGPUTimersEnabled(bool enabled) { gpuTimersEnabled = enabled; }
+	bool areGPUTimersEnabled() const { return gpuTimersEnabled; }
+
 	void finalizeFrame() {
+		std::lock_guard<std::mutex> lock(mutex);
 		for (auto& [_, timer] : timers)
 		{
 			timer.finalizeFrame();
@@ -56,6 +74,7 @@ public:
 	}
 
 	void drawImGui() {
+		std::lock_guard<std::mutex> lock(mutex);
 		ImGui::Begin("Performance Monitor");
 		for (auto& [name, timer] : timers) {
 			ImGui::Text("%s:	\n	Last %.3f ms \n	Avg %.3f ms \n	Max %.3f ms \n	Total %.3f ms \n	Ticks %d",
@@ -66,8 +85,19 @@ public:
 		ImGui::End();
 	}
 
+	// Copy for tools that report timings without ImGui (headless runner, bench), sorted by name; taken under
+	// the lock, since the simulation thread may be adding samples meanwhile
+	std::map<std::string, TimerStats> getTimers() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return std::map<std::string, TimerStats>(timers.begin(), timers.end());
+	}
+	void reset() { std::lock_guard<std::mutex> lock(mutex); timers.clear(); }
+
 private:
 	std::unordered_map<std::string, TimerStats> timers;
+	mutable std::mutex mutex;
+	bool recordSamples = false;
+	bool gpuTimersEnabled = true;
 };
 
 class TimerCPU {
@@ -87,25 +117,31 @@ private:
 	std::chrono::high_resolution_clock::time_point start;
 };
 
+// Uses a pair of timestamp queries rather than a GL_TIME_ELAPSED query, because elapsed-time queries
+// can't be nested and the grid sub-pass timers run inside "Spatial Grid Update"
 class TimerGPU {
 public:
-	TimerGPU(const char* name) : name(name) {
-		glGenQueries(1, &query);
-		glBeginQuery(GL_TIME_ELAPSED, query);
+	TimerGPU(const char* name) : name(name), active(TimerManager::instance().areGPUTimersEnabled()) {
+		if (!active) return;
+		glGenQueries(2, queries);
+		glQueryCounter(queries[0], GL_TIMESTAMP);
 	}
 
 	~TimerGPU() {
-		glEndQuery(GL_TIME_ELAPSED);
+		if (!active) return;
+		glQueryCounter(queries[1], GL_TIMESTAMP);
 
-		GLuint64 ns;
-		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
-		glDeleteQueries(1, &query);
+		GLuint64 startNs, endNs;
+		glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &startNs);
+		glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &endNs);
+		glDeleteQueries(2, queries);
 
-		float ms = ns * 1e-6f;
+		float ms = (endNs - startNs) * 1e-6f;
 		TimerManager::instance().addSample(name, ms);
 	}
 
 private:
-	GLuint query;
+	GLuint queries[2];
 	const char* name;
+	bool active;
 };
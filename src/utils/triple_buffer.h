@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single producer, single consumer hand-off of the latest value
+// The writer fills its own buffer and publishes it by swapping it with the middle one; the reader swaps
+// the middle one with its own buffer whenever a fresh value is waiting. Neither side ever waits for the
+// other, and a value the reader hasn't picked up yet is simply replaced by the next one.
+template <typename T>
+class TripleBuffer {
+public:
+	// Writer side (one thread)
+	T& getWriteBuffer() { return buffers[writeIndex]; }
+	void publish()
+	{
+		uint8_t previous = middle.exchange(static_cast<uint8_t>(writeIndex | FRESH_BIT), std::memory_order_acq_rel);
+		writeIndex = previous & INDEX_MASK;
+	}
+
+	// Reader side (one thread): false if nothing was published since the last acquire
+	bool acquire()
+	{
+		if ((middle.load(std::memory_order_acquire) & FRESH_BIT) == 0)
+			return false;
+
+		uint8_t previous = middle.exchange(static_cast<uint8_t>(readIndex), std::memory_order_acq_rel);
+		readIndex = previous & INDEX_MASK;
+		return true;
+	}
+	const T& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+	static constexpr uint8_t INDEX_MASK = 3;
+	static constexpr uint8_t FRESH_BIT = 4;
+
+	T buffers[3];
+	uint8_t writeIndex = 0;
+	uint8_t readIndex = 1;
+	std::atomic<uint8_t> middle{ 2 };
+};